@@ -0,0 +1,58 @@
+#-------------------------------------------------
+#
+# Paint benchmark of the player and editor boards
+#
+#-------------------------------------------------
+
+QT       += core gui widgets
+
+TARGET = kkrbench
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += c++11
+
+TEMPLATE = app
+
+
+SOURCES += main.cpp \
+    syntheticboard.cpp \
+    paintbench.cpp \
+    playerbench.cpp \
+    editorbench.cpp \
+    ../Kakuro/kkrboard.cpp \
+    ../Kakuro/navigationtable.cpp \
+    ../Kakuro/boardrenderer.cpp \
+    ../Kakuro/problemdata.cpp \
+    ../Kakuro/playstatus.cpp \
+    ../Kakuro/useranswer.cpp \
+    ../Kakuro/useranswermanager.cpp \
+    ../Kakuro/answerjournal.cpp \
+    ../Kakuro/answercheck.cpp \
+    ../Kakuro/inputdrag.cpp \
+    ../Kakuro/inputfactory.cpp \
+    ../Editor/kkrworkboard.cpp \
+    ../Editor/kkrboardmanager.cpp \
+    ../Common/glyphatlas.cpp \
+    ../Common/boardpainter.cpp
+
+HEADERS += paintbench.h \
+    syntheticboard.h \
+    ../Kakuro/kkrboard.h \
+    ../Kakuro/navigationtable.h \
+    ../Kakuro/boardrenderer.h \
+    ../Kakuro/problemdata.h \
+    ../Kakuro/playstatus.h \
+    ../Kakuro/useranswer.h \
+    ../Kakuro/useranswermanager.h \
+    ../Kakuro/answerjournal.h \
+    ../Kakuro/answercheck.h \
+    ../Kakuro/inputdrag.h \
+    ../Kakuro/inputfactory.h \
+    ../Common/cosmetic.h \
+    ../Editor/kkrworkboard.h \
+    ../Editor/kkrboardmanager.h \
+    ../Editor/boarddata.h \
+    ../Common/glyphatlas.h \
+    ../Common/boardpainter.h
+
+INCLUDEPATH += ../Kakuro ../Editor ../Common
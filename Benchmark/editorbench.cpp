@@ -0,0 +1,90 @@
+#include "paintbench.h"
+#include <QScrollArea>
+#include <QScrollBar>
+#include <memory>
+#include "kkrworkboard.h"
+#include "kkrboardmanager.h"
+
+namespace {
+
+class TimedBoardView : public KkrBoardView
+{
+public:
+    FrameStats *pStats = nullptr;
+
+    explicit TimedBoardView(KkrBoardManager *pBoardData) : KkrBoardView(pBoardData) {}
+
+protected:
+    void paintEvent(QPaintEvent *e) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        KkrBoardView::paintEvent(e);
+        if(pStats != nullptr)
+            pStats->addPaint(timer.nsecsElapsed());
+    }
+};
+
+std::shared_ptr<const BoardData> makeBoardData(const SyntheticBoard &board)
+{
+    // closed clues cannot be set through BoardData; they stay empty
+    std::shared_ptr<BoardData> pData{new BoardData(board.getNumCols(), board.getNumRows())};
+    for(int r = 0; r < board.getNumRows(); ++r) {
+        for(int c = 0; c < board.getNumCols(); ++c) {
+            if(board.isClue(c, r)) {
+                if(c > 0 && r > 0)
+                    pData->setCellType(c, r, CellType::CellClue);
+                pData->setClueRight(c, r, board.getClueRight(c, r));
+                pData->setClueDown(c, r, board.getClueDown(c, r));
+            } else {
+                pData->setAnswer(c, r, board.getAnswer(c, r));
+            }
+        }
+    }
+    return pData;
+}
+
+}   // namespace
+
+void benchEditor(const SyntheticBoard &board, const BenchOptions &options, QTextStream &out)
+{
+    KkrBoardManager manager;
+    QScrollArea scrollArea;
+    TimedBoardView *pView = new TimedBoardView{&manager};
+    scrollArea.setWidget(pView);
+    pView->setScrollArea(&scrollArea);
+    manager.slRead(makeBoardData(board));
+    scrollArea.resize(options.viewport);
+    scrollArea.show();
+    QCoreApplication::processEvents();
+
+    FrameStats full, value, cursor, scroll;
+
+    pView->pStats = &full;
+    runFrames(full, options.frames, [pView](int) {pView->update();});
+
+    // the cursor starts at (0, 0); (0, 1) has an open right clue to type in
+    sendKey(pView, Qt::Key_Down);
+    QCoreApplication::processEvents();
+    pView->pStats = &value;
+    runFrames(value, options.frames, [pView](int i) {sendKey(pView, Qt::Key_1 + i % 9);});
+
+    pView->pStats = &cursor;
+    runFrames(cursor, options.frames, [pView](int i) {sendKey(pView, i % 2 == 0 ? Qt::Key_Right : Qt::Key_Left);});
+
+    QScrollBar *pBar = scrollArea.horizontalScrollBar();
+    const int step = 2 * (CELL_WIDTH + BORDER_THICK);
+    int direction = 1;
+    pView->pStats = &scroll;
+    runFrames(scroll, options.frames, [pBar, step, &direction](int) {
+        if(pBar->value() + direction * step > pBar->maximum() || pBar->value() + direction * step < 0)
+            direction = -direction;
+        pBar->setValue(pBar->value() + direction * step);
+    });
+    pView->pStats = nullptr;
+
+    full.report(out, "editor", "full");
+    value.report(out, "editor", "value");
+    cursor.report(out, "editor", "cursor");
+    scroll.report(out, "editor", "scroll");
+}
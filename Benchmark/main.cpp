@@ -0,0 +1,95 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include "paintbench.h"
+#include "syntheticboard.h"
+
+namespace {
+
+// "<w>x<h>" -> QSize; invalid on error
+QSize parseSize(const QString &text)
+{
+    const QStringList parts{text.split('x')};
+    if(parts.size() != 2)
+        return QSize();
+    bool okWidth, okHeight;
+    const QSize size{parts[0].toInt(&okWidth), parts[1].toInt(&okHeight)};
+    return okWidth && okHeight ? size : QSize();
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    // paint into the platform's backing store image, no window system needed
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication a(argc, argv);
+    QCoreApplication::setApplicationName("kkrbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measure paint time of the player and editor boards.");
+    parser.addHelpOption();
+    QCommandLineOption optSize{"size", "Board size as <cols>x<rows>, including the clue row and column.", "size", "100x100"};
+    QCommandLineOption optDensity{"density", "Ratio of clue cells inside the board.", "ratio", "0.25"};
+    QCommandLineOption optFrames{"frames", "Frames per scenario.", "n", "200"};
+    QCommandLineOption optViewport{"viewport", "Visible area as <width>x<height>.", "size", "800x600"};
+    QCommandLineOption optSeed{"seed", "Random seed of the board layout.", "n", "1"};
+    QCommandLineOption optWidget{"widget", "player, editor or all.", "name", "all"};
+    parser.addOption(optSize);
+    parser.addOption(optDensity);
+    parser.addOption(optFrames);
+    parser.addOption(optViewport);
+    parser.addOption(optSeed);
+    parser.addOption(optWidget);
+    parser.process(a);
+
+    QTextStream err(stderr);
+    const QSize boardSize{parseSize(parser.value(optSize))};
+    if(boardSize.width() < 3 || boardSize.height() < 3 || boardSize.width() > 9999 || boardSize.height() > 9999) {
+        err << "invalid board size: " << parser.value(optSize) << endl;
+        return 1;
+    }
+    bool ok;
+    const double density = parser.value(optDensity).toDouble(&ok);
+    if(!ok || density < 0 || density > 1) {
+        err << "invalid density: " << parser.value(optDensity) << endl;
+        return 1;
+    }
+    BenchOptions options;
+    options.frames = parser.value(optFrames).toInt(&ok);
+    if(!ok || options.frames < 1) {
+        err << "invalid number of frames: " << parser.value(optFrames) << endl;
+        return 1;
+    }
+    options.viewport = parseSize(parser.value(optViewport));
+    if(options.viewport.isEmpty()) {
+        err << "invalid viewport: " << parser.value(optViewport) << endl;
+        return 1;
+    }
+    const unsigned seed = parser.value(optSeed).toUInt(&ok);
+    if(!ok) {
+        err << "invalid seed: " << parser.value(optSeed) << endl;
+        return 1;
+    }
+    const QString widget{parser.value(optWidget)};
+    if(widget != "player" && widget != "editor" && widget != "all") {
+        err << "invalid widget: " << widget << endl;
+        return 1;
+    }
+
+    const SyntheticBoard board{boardSize.width(), boardSize.height(), density, seed};
+
+    QTextStream out(stdout);
+    out << "board " << boardSize.width() << "x" << boardSize.height() << ", density " << density
+        << ", viewport " << options.viewport.width() << "x" << options.viewport.height()
+        << ", " << options.frames << " frames per scenario" << endl;
+    FrameStats::reportHeader(out);
+    if(widget != "editor")
+        benchPlayer(board, options, out);
+    if(widget != "player")
+        benchEditor(board, options, out);
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include "paintbench.h"
+#include <algorithm>
+
+void FrameStats::endFrame()
+{
+    if(m_painted)
+        m_nsecs.push_back(m_current);
+    m_current = 0;
+    m_painted = false;
+}
+
+void FrameStats::reportHeader(QTextStream &out)
+{
+    out << qSetFieldWidth(8) << left << "widget" << qSetFieldWidth(10) << "scenario"
+        << right << qSetFieldWidth(8) << "frames" << "first" << "p50" << "p90" << "p99" << "max"
+        << qSetFieldWidth(0) << "  (ms)" << endl;
+}
+
+void FrameStats::report(QTextStream &out, const QString &widget, const QString &scenario) const
+{
+    out << qSetFieldWidth(8) << left << widget << qSetFieldWidth(10) << scenario
+        << right << qSetFieldWidth(8) << static_cast<int>(m_nsecs.size());
+    if(m_nsecs.empty()) {
+        out << qSetFieldWidth(0) << endl;
+        return;
+    }
+
+    std::vector<qint64> sorted{m_nsecs};
+    std::sort(sorted.begin(), sorted.end());
+    // nearest rank
+    const auto percentile = [&sorted](int p) {
+        const std::size_t rank = (sorted.size() * p + 99) / 100;
+        return sorted[std::max<std::size_t>(rank, 1) - 1];
+    };
+    const auto ms = [](qint64 nsecs) {return QString::number(nsecs / 1e6, 'f', 3);};
+
+    out << ms(m_nsecs.front()) << ms(percentile(50)) << ms(percentile(90))
+        << ms(percentile(99)) << ms(sorted.back()) << qSetFieldWidth(0) << endl;
+}
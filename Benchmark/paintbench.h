@@ -0,0 +1,69 @@
+#ifndef PAINTBENCH_H
+#define PAINTBENCH_H
+
+#include <QCoreApplication>
+#include <QKeyEvent>
+#include <QSize>
+#include <QString>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <vector>
+#include "syntheticboard.h"
+
+struct BenchOptions {
+    int frames;         // per scenario
+    QSize viewport;     // size of the visible board area
+};
+
+/*
+ * Paint time of each frame of a scenario
+ * A frame is everything painted after one input, e.g. a key or a scroll step;
+ * frames that paint nothing are not counted.
+ */
+class FrameStats
+{
+    std::vector<qint64> m_nsecs;
+    qint64 m_current;
+    bool m_painted;
+
+public:
+    FrameStats() : m_current(0), m_painted(false) {}
+
+    void addPaint(qint64 nsecs) {m_current += nsecs; m_painted = true;}
+        // called from paintEvent(); one frame may have several paint events
+    void endFrame();
+
+    void report(QTextStream &out, const QString &widget, const QString &scenario) const;
+        // one line: # of frames, first frame and percentiles in ms
+    static void reportHeader(QTextStream &out);
+};
+
+template<typename Input>
+void runFrames(FrameStats &stats, int frames, Input input)
+    // input(i) triggers frame i; the repaint happens in the event loop
+{
+    for(int i = 0; i < frames; ++i) {
+        input(i);
+        QCoreApplication::processEvents();
+        stats.endFrame();
+    }
+}
+
+inline void sendKey(QObject *pReceiver, int key)
+    // both views act on key release
+{
+    QKeyEvent e{QEvent::KeyRelease, key, Qt::NoModifier};
+    QCoreApplication::sendEvent(pReceiver, &e);
+}
+
+/*
+ * Scenarios: full repaint, cursor move, single answer change, scroll
+ * Widgets are shown on the current platform and repainted through the event
+ * loop, so the update regions are the ones the widgets request.
+ */
+void benchPlayer(const SyntheticBoard &board, const BenchOptions &options, QTextStream &out);
+    // KkrBoard
+void benchEditor(const SyntheticBoard &board, const BenchOptions &options, QTextStream &out);
+    // KkrBoardView in a QScrollArea, as in the editor
+
+#endif // PAINTBENCH_H
@@ -0,0 +1,88 @@
+#include "paintbench.h"
+#include <QTemporaryDir>
+#include <QScrollBar>
+#include <memory>
+#include "kkrboard.h"
+#include "problemdata.h"
+#include "playstatus.h"
+#include "useranswermanager.h"
+
+namespace pd = problemdata;
+namespace ua = useranswer;
+
+namespace {
+
+class TimedBoard : public KkrBoard
+{
+public:
+    FrameStats *pStats = nullptr;
+
+protected:
+    void paintEvent(QPaintEvent *e) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        KkrBoard::paintEvent(e);
+        if(pStats != nullptr)
+            pStats->addPaint(timer.nsecsElapsed());
+    }
+};
+
+}   // namespace
+
+void benchPlayer(const SyntheticBoard &board, const BenchOptions &options, QTextStream &out)
+{
+    QTemporaryDir dir;
+    const QString problemFile{dir.path() + "/bench.kkr"};
+    if(!dir.isValid() || !board.save(problemFile)) {
+        out << "player: cannot write " << problemFile << endl;
+        return;
+    }
+    std::shared_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(problemFile)};
+    if(pData == nullptr) {
+        out << "player: cannot load " << problemFile << endl;
+        return;
+    }
+
+    // wired as in the main window
+    TimedBoard view;
+    ua::UserAnswerManager uam;
+    QObject::connect(&uam, &ua::UserAnswerManager::newUserAnswer, &view, &KkrBoard::updateUserAnswer);
+    QObject::connect(&view, &KkrBoard::newAnswerInput, &uam, &ua::UserAnswerManager::updateCellAnswer);
+    QObject::connect(&uam, &ua::UserAnswerManager::newCellAnswer, &view, &KkrBoard::renderAnswer);
+    view.updateProblem(pData);
+    uam.updateProblem(pData);
+    view.updateStatus(playstatus::Status::INPLAY);
+    view.resize(options.viewport);
+    view.show();
+    QCoreApplication::processEvents();
+
+    // the cursor starts at (1, 1), an answer cell
+    FrameStats full, answer, cursor, scroll;
+
+    view.pStats = &full;
+    runFrames(full, options.frames, [&view](int) {view.viewport()->update();});
+
+    view.pStats = &answer;
+    runFrames(answer, options.frames, [&view](int i) {sendKey(&view, Qt::Key_1 + i % 9);});
+
+    view.pStats = &cursor;
+    runFrames(cursor, options.frames, [&view](int i) {sendKey(&view, i % 2 == 0 ? Qt::Key_Right : Qt::Key_Left);});
+
+    // back and forth across the board
+    QScrollBar *pBar = view.horizontalScrollBar();
+    const int step = 2 * (CELL_WIDTH + BORDER_THICK);
+    int direction = 1;
+    view.pStats = &scroll;
+    runFrames(scroll, options.frames, [pBar, step, &direction](int) {
+        if(pBar->value() + direction * step > pBar->maximum() || pBar->value() + direction * step < 0)
+            direction = -direction;
+        pBar->setValue(pBar->value() + direction * step);
+    });
+    view.pStats = nullptr;
+
+    full.report(out, "player", "full");
+    answer.report(out, "player", "answer");
+    cursor.report(out, "player", "cursor");
+    scroll.report(out, "player", "scroll");
+}
@@ -0,0 +1,51 @@
+#include "syntheticboard.h"
+#include <QFile>
+#include <algorithm>
+#include <random>
+
+SyntheticBoard::SyntheticBoard(int cols, int rows, double clueDensity, unsigned seed)
+    : m_cols(cols)
+    , m_rows(rows)
+    , m_cells(cols * rows, ANSWER_CLUE)
+{
+    std::mt19937 rng{seed};
+    std::bernoulli_distribution clue{clueDensity};
+    std::uniform_int_distribution<int> digit{1, 9};
+
+    for(int r = 1; r < m_rows; ++r)
+        for(int c = 1; c < m_cols; ++c)
+            if((c == 1 && r == 1) || !clue(rng))
+                m_cells[c2i(c, r)] = digit(rng);
+}
+
+int SyntheticBoard::runSum(int col, int row, int dc, int dr) const
+{
+    int sum = 0;
+    for(int c = col + dc, r = row + dr; c < m_cols && r < m_rows && !isClue(c, r); c += dc, r += dr)
+        sum += getAnswer(c, r);
+    return std::min(sum, MAX_CLUE);
+}
+
+bool SyntheticBoard::save(const QString &fileName) const
+{
+    QFile f{fileName};
+    if(!f.open(QIODevice::WriteOnly))
+        return false;
+
+    QByteArray data{"KKRP0000"};
+    data += QByteArray::number(m_cols).rightJustified(4, '0');
+    data += QByteArray::number(m_rows).rightJustified(4, '0');
+    for(int r = 0; r < m_rows; ++r) {
+        for(int c = 0; c < m_cols; ++c) {
+            if(isClue(c, r)) {
+                data += '1';
+                data += QByteArray::number(getClueRight(c, r)).rightJustified(2, '0');
+                data += QByteArray::number(getClueDown(c, r)).rightJustified(2, '0');
+            } else {
+                data += '0';
+                data += QByteArray::number(getAnswer(c, r));
+            }
+        }
+    }
+    return f.write(data) == data.size();
+}
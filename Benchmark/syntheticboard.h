@@ -0,0 +1,40 @@
+#ifndef SYNTHETICBOARD_H
+#define SYNTHETICBOARD_H
+
+#include <QString>
+#include <vector>
+
+/*
+ * Random board layout for benchmarks
+ * Not a valid puzzle: answers are random digits and clues are the sums of
+ * their runs capped at 45. The top row and the left column are clue cells,
+ * and (1, 1) is always an answer cell.
+ */
+class SyntheticBoard
+{
+    int m_cols;
+    int m_rows;
+    std::vector<int> m_cells;   // ANSWER_CLUE for clue cells, else 1-9
+
+    int c2i(int c, int r) const {return r * m_cols + c;}
+    int runSum(int col, int row, int dc, int dr) const;
+
+public:
+    static const int ANSWER_CLUE = 0;
+    static const int MAX_CLUE = 45;
+
+    SyntheticBoard(int cols, int rows, double clueDensity, unsigned seed);
+
+    int getNumCols() const {return m_cols;}
+    int getNumRows() const {return m_rows;}
+    bool isClue(int col, int row) const {return m_cells[c2i(col, row)] == ANSWER_CLUE;}
+    int getAnswer(int col, int row) const {return m_cells[c2i(col, row)];}
+    int getClueRight(int col, int row) const {return runSum(col, row, 1, 0);}
+    int getClueDown(int col, int row) const {return runSum(col, row, 0, 1);}
+        // 0 if no run follows the clue cell
+
+    bool save(const QString &fileName) const;
+        // write in the player's problem format (version 0)
+};
+
+#endif // SYNTHETICBOARD_H
@@ -0,0 +1,212 @@
+#include "boardpainter.h"
+#include <algorithm>
+#include <array>
+
+BoardPainter::BoardPainter(TextMode textMode)
+    : m_textMode(textMode)
+    , m_glyphs(FONT_ANS, CELL_WIDTH, FONT_CLUE, CLUE_WIDTH)
+    , m_fontAns(FONT_ANS)
+    , m_fontClue(FONT_CLUE)
+{
+    m_fontAns.setPixelSize(CELL_WIDTH);
+    m_fontClue.setPixelSize(CLUE_WIDTH);
+
+    m_brushes[static_cast<int>(Fill::Foreground)] = QBrush(Qt::black);
+    m_brushes[static_cast<int>(Fill::Background)] = QBrush(Qt::white);
+    m_brushes[static_cast<int>(Fill::Cursor)] = QBrush(Qt::cyan);
+    m_brushes[static_cast<int>(Fill::Mistake)] = QBrush(QColor(255, 192, 192));
+    m_brushes[static_cast<int>(Fill::Ambiguous)] = QBrush(QColor(255, 240, 160));
+    m_brushes[static_cast<int>(Fill::Selection)] = QBrush(QColor(0, 128, 255, 64));
+
+    const QRect cellRect{0, 0, CELL_WIDTH, CELL_WIDTH};
+    m_triangleRight << cellRect.topLeft() + QPoint(2,1)
+                    << cellRect.topRight() + QPoint(-1,1)
+                    << cellRect.bottomRight() + QPoint(-1,-2);
+    m_triangleDown << cellRect.topLeft() + QPoint(1,2)
+                   << cellRect.bottomLeft() + QPoint(1,-1)
+                   << cellRect.bottomRight() + QPoint(-2,-1);
+}
+
+/*
+ * geometry
+ */
+static const int ORIGIN = MARGIN + FRAME_THICK;
+static const int CELL_FRAME_WIDTH = CELL_WIDTH + BORDER_THICK;
+
+static int innerSize(int numCells)
+{
+    return CELL_FRAME_WIDTH * numCells - BORDER_THICK;
+}
+
+QSize BoardPainter::getBoardSize(int numCols, int numRows)
+{
+    return QSize(2*(MARGIN + FRAME_THICK) + innerSize(numCols),
+                 2*(MARGIN + FRAME_THICK) + innerSize(numRows));
+}
+
+QRect BoardPainter::getCellRect(int col, int row)
+{
+    const int x = ORIGIN + col * CELL_FRAME_WIDTH;
+    const int y = ORIGIN + row * CELL_FRAME_WIDTH;
+    return QRect(x, y, CELL_WIDTH, CELL_WIDTH);
+}
+
+QRect BoardPainter::getBlockRect(const QRect &cells)
+{
+    if(cells.isEmpty())
+        return QRect();
+    return QRect(getCellRect(cells.left(), cells.top()).topLeft(),
+                 getCellRect(cells.right(), cells.bottom()).bottomRight());
+}
+
+QRect BoardPainter::getClueRectRight(const QRect &cellRect)
+{
+    const QPoint topRight{cellRect.topRight()};
+    const int x = topRight.x() - CLUE_WIDTH - 1;
+    const int y = topRight.y() + 2;
+    return QRect(x, y, CLUE_WIDTH, CLUE_WIDTH);
+}
+
+QRect BoardPainter::getClueRectDown(const QRect &cellRect)
+{
+    const QPoint bottomLeft{cellRect.bottomLeft()};
+    const int x = bottomLeft.x() + 2;
+    const int y = bottomLeft.y() - CLUE_WIDTH - 1;
+    return QRect(x, y, CLUE_WIDTH, CLUE_WIDTH);
+}
+
+QPoint BoardPainter::getCellCoord(int numCols, int numRows, int x, int y)
+{
+    QPoint ret(-1, -1);
+
+    x -= ORIGIN; y -= ORIGIN;
+    if(x < 0 || y < 0)
+        return ret;
+
+    if(x % CELL_FRAME_WIDTH == CELL_WIDTH || y % CELL_FRAME_WIDTH == CELL_WIDTH)
+        return ret; // on the cell border
+
+    const int col = x / CELL_FRAME_WIDTH;
+    const int row = y / CELL_FRAME_WIDTH;
+    if(col >= numCols || row >= numRows)
+        return ret;
+
+    ret.setX(col); ret.setY(row);
+
+    return ret;
+}
+
+QRect BoardPainter::getCellRange(int numCols, int numRows, const QRect &rect)
+{
+    // a cell owns the border on its right/bottom for this purpose
+    const int left = std::max(rect.left() - ORIGIN, 0) / CELL_FRAME_WIDTH;
+    const int top = std::max(rect.top() - ORIGIN, 0) / CELL_FRAME_WIDTH;
+    if(rect.right() < ORIGIN || rect.bottom() < ORIGIN)
+        return QRect();
+    const int right = std::min((rect.right() - ORIGIN) / CELL_FRAME_WIDTH, numCols - 1);
+    const int bottom = std::min((rect.bottom() - ORIGIN) / CELL_FRAME_WIDTH, numRows - 1);
+
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+/*
+ * painting
+ */
+void BoardPainter::paintFrame(QPainter &p, int numCols, int numRows, const QRect &area) const
+{
+    const int frameWidth = 2*FRAME_THICK + innerSize(numCols);
+    const int frameHeight = 2*FRAME_THICK + innerSize(numRows);
+    const std::array<QRect, 4> frame{{
+        QRect(MARGIN, MARGIN, frameWidth, FRAME_THICK),
+        QRect(MARGIN, MARGIN+frameHeight-FRAME_THICK, frameWidth, FRAME_THICK),
+        QRect(MARGIN, MARGIN, FRAME_THICK, frameHeight),
+        QRect(MARGIN+frameWidth-FRAME_THICK, MARGIN, FRAME_THICK, frameHeight)
+    }};
+    for(const auto &r : frame)
+        if(r.intersects(area))
+            p.fillRect(r & area, getBrush(Fill::Foreground));
+}
+
+void BoardPainter::paintBorders(QPainter &p, int numCols, int numRows, const QRect &area) const
+{
+    const QRect range{getCellRange(numCols, numRows, area)};
+    if(range.isEmpty())
+        return;
+
+    const int lastRow = std::min(range.bottom() + 1, numRows - 1);
+    for(int yi = std::max(range.top(), 1); yi <= lastRow; ++yi) {
+        const int y = ORIGIN - BORDER_THICK + yi * CELL_FRAME_WIDTH;
+        p.fillRect(QRect(ORIGIN, y, innerSize(numCols), BORDER_THICK) & area, getBrush(Fill::Foreground));
+    }
+
+    const int lastCol = std::min(range.right() + 1, numCols - 1);
+    for(int xi = std::max(range.left(), 1); xi <= lastCol; ++xi) {
+        const int x = ORIGIN - BORDER_THICK + xi * CELL_FRAME_WIDTH;
+        p.fillRect(QRect(x, ORIGIN, BORDER_THICK, innerSize(numRows)) & area, getBrush(Fill::Foreground));
+    }
+}
+
+void BoardPainter::paintGrid(QPainter &p, int numCols, int numRows, const QRect &area) const
+{
+    const QRect range{getCellRange(numCols, numRows, area)};
+    if(range.isEmpty())
+        return;
+
+    p.setPen(QPen(Qt::gray, 0));
+    for(int yi = std::max(range.top(), 1); yi <= range.bottom(); ++yi) {
+        const int y = ORIGIN - BORDER_THICK + yi * CELL_FRAME_WIDTH;
+        p.drawLine(ORIGIN, y, ORIGIN + innerSize(numCols), y);
+    }
+    for(int xi = std::max(range.left(), 1); xi <= range.right(); ++xi) {
+        const int x = ORIGIN - BORDER_THICK + xi * CELL_FRAME_WIDTH;
+        p.drawLine(x, ORIGIN, x, ORIGIN + innerSize(numRows));
+    }
+}
+
+void BoardPainter::drawClueCell(QPainter &p, int col, int row, int clueRight, int clueDown,
+                                bool showDigits, ClueHighlight highlight, int marks) const
+{
+    const QRect cellRect{getCellRect(col, row)};
+
+    p.setPen(Qt::black);
+    p.setBrush(getBrush(highlight == ClueHighlight::Cell ? Fill::Cursor : Fill::Foreground));
+    p.translate(cellRect.topLeft());
+    p.drawPolygon(m_triangleRight);
+    p.drawPolygon(m_triangleDown);
+    p.translate(-cellRect.topLeft());
+
+    if(clueRight != CLOSED_CLUE) {
+        const Fill fill = highlight == ClueHighlight::Right ? Fill::Cursor
+                        : (marks & MarkRight) ? Fill::Mistake : Fill::Background;
+        drawClue(p, getClueRectRight(cellRect), clueRight, showDigits, fill);
+    }
+    if(clueDown != CLOSED_CLUE) {
+        const Fill fill = highlight == ClueHighlight::Down ? Fill::Cursor
+                        : (marks & MarkDown) ? Fill::Mistake : Fill::Background;
+        drawClue(p, getClueRectDown(cellRect), clueDown, showDigits, fill);
+    }
+}
+
+void BoardPainter::drawClue(QPainter &p, const QRect &clueRect, int value, bool showDigits,
+                            Fill fill) const
+{
+    p.fillRect(clueRect, getBrush(fill));
+    if(showDigits && value != 0)
+        drawDigits(p, clueRect, GlyphAtlas::Style::Clue, value);
+}
+
+void BoardPainter::drawAnswer(QPainter &p, int col, int row, int answer) const
+{
+    drawDigits(p, getCellRect(col, row), GlyphAtlas::Style::Answer, answer);
+}
+
+void BoardPainter::drawDigits(QPainter &p, const QRect &rect, GlyphAtlas::Style style, int value) const
+{
+    if(m_textMode == TextMode::Glyphs) {
+        m_glyphs.draw(p, rect, style, value);
+    } else {
+        p.setFont(style == GlyphAtlas::Style::Answer ? m_fontAns : m_fontClue);
+        p.setPen(Qt::black);
+        p.drawText(rect, Qt::AlignCenter, QString::number(value));
+    }
+}
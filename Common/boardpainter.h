@@ -0,0 +1,103 @@
+#ifndef BOARDPAINTER_H
+#define BOARDPAINTER_H
+
+#include <QBrush>
+#include <QFont>
+#include <QPainter>
+#include <QPoint>
+#include <QPolygon>
+#include <QRect>
+#include <QSize>
+#include "cosmetic.h"
+#include "glyphatlas.h"
+
+/*
+ * Rendering core shared by the player and the editor
+ * Board geometry and painters for the frame, the borders and single cells.
+ * The cell contents come from the caller, so the same code draws a problem
+ * in the player and the board being edited in the editor.
+ * Geometry is in board coord, i.e. pixels at zoom 1.0. The glyph atlas is
+ * not shared, so each thread needs its own painter.
+ */
+class BoardPainter
+{
+public:
+    enum class TextMode {
+        Glyphs,     // blit pre-rendered digits; fast on raster devices
+        Text        // QPainter::drawText; keeps digits as text in vector output
+    };
+
+    enum class Fill {
+        Foreground, Background, Cursor, Mistake, Ambiguous, Selection
+    };
+        // Selection is translucent, for painting over the cells
+
+    enum class ClueHighlight {
+        None, Cell, Right, Down
+    };
+        // the editor's cursor on a clue cell: on the triangles or on one clue
+
+    enum ClueMark {
+        MarkNone = 0, MarkRight = 0x1, MarkDown = 0x2
+    };
+        // clue boxes filled as mistakes; or'ed together
+
+    static const int CLOSED_CLUE = -1;
+        // no box is drawn; 0 is an open clue box without a digit
+
+private:
+    static const int NUM_FILLS = 6;
+
+    TextMode m_textMode;
+    GlyphAtlas m_glyphs;
+    QFont m_fontAns;
+    QFont m_fontClue;
+    QBrush m_brushes[NUM_FILLS];
+    QPolygon m_triangleRight;
+    QPolygon m_triangleDown;
+        // clue cell triangles relative to the top left of the cell
+
+    void drawClue(QPainter &p, const QRect &clueRect, int value, bool showDigits, Fill fill) const;
+
+public:
+    explicit BoardPainter(TextMode textMode = TextMode::Glyphs);
+
+    BoardPainter(const BoardPainter &) = delete;
+    BoardPainter &operator=(const BoardPainter &) = delete;
+
+    /*
+     * geometry
+     */
+    static QSize getBoardSize(int numCols, int numRows);
+        // including the margin
+    static QRect getCellRect(int col, int row);
+    static QRect getBlockRect(const QRect &cells);
+        // cells as (left col, top row) - (right col, bottom row) to the board rect
+        // covering them and the borders between them; null if cells is empty
+    static QRect getClueRectRight(const QRect &cellRect);
+    static QRect getClueRectDown(const QRect &cellRect);
+    static QPoint getCellCoord(int numCols, int numRows, int x, int y);
+        // if board coord is not on a cell, returns (-1, -1)
+    static QRect getCellRange(int numCols, int numRows, const QRect &rect);
+        // cells intersecting rect as (left col, top row) - (right col, bottom row)
+        // empty if no cell intersects
+
+    const QBrush &getBrush(Fill fill) const {return m_brushes[static_cast<int>(fill)];}
+
+    /*
+     * painting; area is in board coord
+     */
+    void paintFrame(QPainter &p, int numCols, int numRows, const QRect &area) const;
+    void paintBorders(QPainter &p, int numCols, int numRows, const QRect &area) const;
+        // the borders next to the cells intersecting area
+    void paintGrid(QPainter &p, int numCols, int numRows, const QRect &area) const;
+        // hairline borders for small scales
+    void drawClueCell(QPainter &p, int col, int row, int clueRight, int clueDown, bool showDigits,
+                      ClueHighlight highlight = ClueHighlight::None, int marks = MarkNone) const;
+        // clues are CLOSED_CLUE or 0-45; the highlight wins over the marks
+    void drawAnswer(QPainter &p, int col, int row, int answer) const;
+        // digit only; the cell background is up to the caller
+    void drawDigits(QPainter &p, const QRect &rect, GlyphAtlas::Style style, int value) const;
+};
+
+#endif // BOARDPAINTER_H
@@ -0,0 +1,91 @@
+#include "glyphatlas.h"
+#include <QFontMetrics>
+#include <QPaintDevice>
+#include <algorithm>
+
+/*
+ * atlas layout
+ *  row 0: answers 0 .. MAX_ANSWER in answer slots
+ *  row 1: clues 0 .. MAX_CLUE in clue slots
+ * slots are at least the glyph square, widened for two-digit clues, and
+ * separated by GUTTER transparent pixels
+ */
+
+GlyphAtlas::GlyphAtlas(const QString &fontAns, int answerSize, const QString &fontClue, int clueSize)
+    : m_fontAns(fontAns)
+    , m_fontClue(fontClue)
+    , m_answerSize(answerSize)
+    , m_clueSize(clueSize)
+{
+    m_fontAns.setPixelSize(answerSize);
+    m_fontClue.setPixelSize(clueSize);
+    m_answerSlot = slotSize(m_fontAns, answerSize, MAX_ANSWER);
+    m_clueSlot = slotSize(m_fontClue, clueSize, MAX_CLUE);
+}
+
+QSize GlyphAtlas::slotSize(const QFont &font, int glyphSize, int maxValue)
+{
+    const QFontMetrics fm{font};
+    int width = glyphSize;
+    for(int v = 0; v <= maxValue; ++v) {
+        const QString text{QString::number(v)};
+        width = std::max(width, std::max(fm.width(text), fm.boundingRect(text).width()));
+    }
+    const int height = std::max(glyphSize, fm.height());
+    return QSize(width + 2*PADDING, height + 2*PADDING);
+}
+
+QRect GlyphAtlas::sourceRect(Style style, int value) const
+{
+    if(style == Style::Answer)
+        return QRect(QPoint(GUTTER + value * (m_answerSlot.width() + GUTTER), GUTTER), m_answerSlot);
+    else
+        return QRect(QPoint(GUTTER + value * (m_clueSlot.width() + GUTTER),
+                            2*GUTTER + m_answerSlot.height()), m_clueSlot);
+}
+
+const GlyphAtlas::Atlas &GlyphAtlas::atlasFor(qreal scale) const
+{
+    for(const auto &atlas : m_atlases)
+        if(atlas.scale == scale)
+            return atlas;
+
+    const int width = GUTTER + std::max((MAX_ANSWER+1) * (m_answerSlot.width() + GUTTER),
+                                        (MAX_CLUE+1) * (m_clueSlot.width() + GUTTER));
+    const int height = 3*GUTTER + m_answerSlot.height() + m_clueSlot.height();
+
+    Atlas atlas;
+    atlas.scale = scale;
+    atlas.image = QImage(QSize(width, height) * scale, QImage::Format_ARGB32_Premultiplied);
+    atlas.image.setDevicePixelRatio(scale);
+    atlas.image.fill(Qt::transparent);
+
+    QPainter p(&atlas.image);
+    p.setFont(m_fontAns);
+    for(int v = 0; v <= MAX_ANSWER; ++v)
+        p.drawText(sourceRect(Style::Answer, v), Qt::AlignCenter, QString::number(v));
+    p.setFont(m_fontClue);
+    for(int v = 0; v <= MAX_CLUE; ++v)
+        p.drawText(sourceRect(Style::Clue, v), Qt::AlignCenter, QString::number(v));
+    p.end();
+
+    m_atlases.push_back(atlas);
+    return m_atlases.back();
+}
+
+void GlyphAtlas::draw(QPainter &p, const QRect &rect, Style style, int value) const
+{
+    Q_ASSERT(0 <= value && value <= (style == Style::Answer ? MAX_ANSWER : MAX_CLUE));
+
+    // glyphs are rendered at the resolution they end up on the device
+    const qreal scale = p.device()->devicePixelRatioF() * p.worldTransform().m11();
+    const Atlas &atlas = atlasFor(scale);
+    const QRect src{sourceRect(style, value)};
+
+    // centered like drawText would do
+    QRect target{QPoint(0, 0), src.size()};
+    target.moveCenter(rect.center());
+
+    const QRectF srcDevice{QPointF(src.topLeft()) * scale, QSizeF(src.size()) * scale};
+    p.drawImage(QRectF(target), atlas.image, srcDevice);
+}
@@ -0,0 +1,62 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <QFont>
+#include <QImage>
+#include <QPainter>
+#include <QRect>
+#include <QString>
+#include <vector>
+
+/*
+ * Pre-rendered digits for the board views
+ * Answers 0-9 and clues 0-45 are rendered once per device scale (device pixel
+ * ratio times the painter's scale) into one image and blitted, which skips
+ * text layout on every paint.
+ * Not thread safe; each thread (or widget) owns its atlas.
+ */
+class GlyphAtlas
+{
+public:
+    enum class Style {
+        Answer, Clue
+    };
+
+    static const int MAX_ANSWER = 9;
+    static const int MAX_CLUE = 45;
+
+    GlyphAtlas(const QString &fontAns, int answerSize, const QString &fontClue, int clueSize);
+        // fonts are used at the pixel size of the glyph squares
+
+    GlyphAtlas(const GlyphAtlas &) = delete;
+    GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+    void draw(QPainter &p, const QRect &rect, Style style, int value) const;
+        // draws value centered in rect with the same layout as
+        // QPainter::drawText(rect, Qt::AlignCenter, value)
+    int getGlyphSize(Style style) const {return style == Style::Answer ? m_answerSize : m_clueSize;}
+
+private:
+    struct Atlas {
+        qreal scale;
+        QImage image;
+    };
+
+    static const int PADDING = 1;   // around the widest glyph in a slot
+    static const int GUTTER = 2;    // between slots, so scaled blits do not bleed
+
+    QFont m_fontAns;
+    QFont m_fontClue;
+    int m_answerSize;
+    int m_clueSize;
+    QSize m_answerSlot;     // fits the widest of 0 .. MAX_ANSWER
+    QSize m_clueSlot;       // fits the widest of 0 .. MAX_CLUE
+    mutable std::vector<Atlas> m_atlases;   // one per device scale in use
+
+    static QSize slotSize(const QFont &font, int glyphSize, int maxValue);
+    const Atlas &atlasFor(qreal scale) const;
+    QRect sourceRect(Style style, int value) const;
+        // glyph position in the atlas in logical pixels
+};
+
+#endif // GLYPHATLAS_H
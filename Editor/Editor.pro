@@ -6,7 +6,7 @@
 
 QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 TARGET = Editor
 TEMPLATE = app
@@ -18,7 +18,15 @@ SOURCES += main.cpp\
     metadatamanager.cpp \
     metadataview.cpp \
     kkrboardmanager.cpp \
-    dialognew.cpp
+    dialognew.cpp \
+    dialogresize.cpp \
+    dialoglayout.cpp \
+    layoutgenerator.cpp \
+    kkrsolver.cpp \
+    uniquenesschecker.cpp \
+    boardfile.cpp \
+    ../Common/glyphatlas.cpp \
+    ../Common/boardpainter.cpp
 
 HEADERS  += kkreditmain.h \
     kkrworkboard.h \
@@ -26,5 +34,16 @@ HEADERS  += kkreditmain.h \
     metadataview.h \
     kkrboardmanager.h \
     dialognew.h \
+    dialogresize.h \
+    dialoglayout.h \
+    layoutgenerator.h \
+    kkrsolver.h \
+    uniquenesschecker.h \
+    boardfile.h \
     metadata.h \
-    boarddata.h
+    boarddata.h \
+    ../Common/glyphatlas.h \
+    ../Common/boardpainter.h \
+    ../Common/cosmetic.h
+
+INCLUDEPATH += ../Common
@@ -1,6 +1,11 @@
 #ifndef BOARDDATA_H
 #define BOARDDATA_H
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 enum class CellType {
     CellAnswer,
     CellClue
@@ -21,10 +26,52 @@ struct Cell {
     };
 };
 
+/*
+ * Cells in fixed size chunks shared between copies
+ * Copying a store shares its chunks, so a snapshot of the largest board
+ * costs a few hundred reference counts; a shared chunk is copied the first
+ * time it is written (copy on write). Copies may be read on other threads;
+ * each store is written on one thread only.
+ */
+class CellStore {
+    static const int CHUNK_BITS = 12;
+    static const int CHUNK_SIZE = 1 << CHUNK_BITS;      // 48 KiB of cells
+    typedef std::array<Cell, CHUNK_SIZE> Chunk;
+
+    std::vector<std::shared_ptr<Chunk>> m_chunks;
+    int m_size;
+
+public:
+    CellStore() : m_size(0) {}
+    explicit CellStore(int size)
+        : m_chunks((size + CHUNK_SIZE - 1) >> CHUNK_BITS)
+        , m_size(size)
+    {
+        for(auto &pChunk : m_chunks)
+            pChunk = std::make_shared<Chunk>();
+    }
+
+    int size() const {return m_size;}
+
+    const Cell &operator[](int i) const {return (*m_chunks[i >> CHUNK_BITS])[i & (CHUNK_SIZE-1)];}
+    Cell &modify(int i)
+    {
+        // another count is a snapshot; it only ever drops meanwhile
+        std::shared_ptr<Chunk> &pChunk = m_chunks[i >> CHUNK_BITS];
+        if(pChunk.use_count() > 1)
+            pChunk = std::make_shared<Chunk>(*pChunk);
+        else
+            // the last snapshot may have been released on a worker thread
+            // that read this chunk; order those reads before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+        return (*pChunk)[i & (CHUNK_SIZE-1)];
+    }
+};
+
 class BoardData {
     const int m_cols;
     const int m_rows;
-    std::vector<Cell> m_data;
+    CellStore m_data;
 
     // col,row to index
     int c2i(int c, int r) const {return r*m_cols + c;}
@@ -33,6 +80,7 @@ public:
     BoardData(int cols, int rows);
     ~BoardData();
     BoardData(const BoardData &rhs);
+        // shares the cells; cheap
 
     BoardData &operator=(const BoardData&) = delete;
 
@@ -51,6 +99,10 @@ public:
     int getAnswer(int col, int row) const;
     void setAnswer(int col, int row, int ans);
 
+private:
+    BoardData(int cols, int rows, const CellStore &cells);
+        // snapshot of the editor board
+
 friend class KkrBoardManager;
 };
 
@@ -0,0 +1,207 @@
+#include "boardfile.h"
+#include <QByteArray>
+#include <QFile>
+#include <QSaveFile>
+#include <cstring>
+
+/*
+ * format
+ */
+static const char HEADER[] = {'K', 'K', 'R', 'P', '0', '0', '0', '1'};
+static const char META_TAG[] = {'K', 'K', 'R', 'M'};
+static const int CELLTYPE_MASK = 0xf0;
+static const int CELLVALUE_MASK = 0x0f;
+static const int CELL_ANSWER = 0x00;
+static const int CELL_CLUE = 0x10;
+static const int VALUE_OFFSET = 46;
+static const int MAX_CLUE = 45;
+static const int NUM_TIMES = 4;
+
+static void putInt(QByteArray &buffer, quint32 value, int numBytes)
+{
+    for(int i = numBytes-1; i >= 0; --i)
+        buffer.append(static_cast<char>((value >> (8*i)) & 0xff));
+}
+
+static bool getInt(const QByteArray &buffer, int &pos, int numBytes, quint32 &value)
+{
+    if(pos + numBytes > buffer.size())
+        return false;
+    value = 0;
+    for(int i = 0; i < numBytes; ++i)
+        value = (value << 8) | static_cast<unsigned char>(buffer[pos++]);
+    return true;
+}
+
+static int clueToFile(int clue)
+{
+    // the player has a single value for no clue
+    return clue == CLOSED_CLUE ? 0 : clue;
+}
+
+/*
+ * save
+ */
+bool saveBoardFile(const QString &fileName, const BoardData &board, const MetaData &meta)
+{
+    const int cols = board.getNumCols();
+    const int rows = board.getNumRows();
+
+    // whole file in memory; a 60x60 board is about 8KB
+    QByteArray buffer;
+    buffer.reserve(sizeof(HEADER) + 4 + cols * rows * 2 + 64);
+    buffer.append(HEADER, sizeof(HEADER));
+    putInt(buffer, cols, 2);
+    putInt(buffer, rows, 2);
+    for(int r = 0; r < rows; ++r) {
+        for(int c = 0; c < cols; ++c) {
+            if(board.getCellType(c, r) == CellType::CellAnswer) {
+                putInt(buffer, CELL_ANSWER | board.getAnswer(c, r), 1);
+            } else {
+                const int value = clueToFile(board.getClueRight(c, r)) * VALUE_OFFSET
+                        + clueToFile(board.getClueDown(c, r));
+                putInt(buffer, CELL_CLUE << 8 | value, 2);
+            }
+        }
+    }
+
+    const QByteArray author{meta.getAuthor().toUtf8()};
+    buffer.append(META_TAG, sizeof(META_TAG));
+    putInt(buffer, author.size(), 2);
+    buffer.append(author);
+    putInt(buffer, meta.getBeginnerTime(), 4);
+    putInt(buffer, meta.getIntermediateTime(), 4);
+    putInt(buffer, meta.getAdvancedTime(), 4);
+    putInt(buffer, meta.getExpertTime(), 4);
+
+    QSaveFile f{fileName};
+    if(!f.open(QIODevice::WriteOnly))
+        return false;
+    if(f.write(buffer) != buffer.size()) {
+        f.cancelWriting();
+        return false;
+    }
+    return f.commit();
+}
+
+/*
+ * load
+ */
+static std::shared_ptr<BoardData> readCells(const QByteArray &buffer, int &pos)
+{
+    quint32 cols, rows;
+    if(!getInt(buffer, pos, 2, cols) || !getInt(buffer, pos, 2, rows))
+        return nullptr;
+    if(cols < 1 || rows < 1)
+        return nullptr;
+    // every cell takes at least a byte; check before allocating for a bogus size
+    const qint64 numCells = static_cast<qint64>(cols) * rows;
+    if(buffer.size() - pos < numCells)
+        return nullptr;
+
+    std::shared_ptr<BoardData> pBoard{new BoardData{static_cast<int>(cols), static_cast<int>(rows)}};
+    std::vector<bool> zeroRight(numCells, false);
+    std::vector<bool> zeroDown(numCells, false);
+    for(int r = 0; r < static_cast<int>(rows); ++r) {
+        for(int c = 0; c < static_cast<int>(cols); ++c) {
+            quint32 cell;
+            if(!getInt(buffer, pos, 1, cell))
+                return nullptr;
+            switch(cell & CELLTYPE_MASK) {
+            case CELL_ANSWER:
+            {
+                const int ans = cell & CELLVALUE_MASK;
+                // the topmost row and the leftmost column are clue cells
+                if(ans > 9 || c == 0 || r == 0)
+                    return nullptr;
+                pBoard->setCellType(c, r, CellType::CellAnswer);
+                pBoard->setAnswer(c, r, ans);
+            }
+                break;
+            case CELL_CLUE:
+            {
+                quint32 low;
+                if(!getInt(buffer, pos, 1, low))
+                    return nullptr;
+                const int value = (cell & CELLVALUE_MASK) << 8 | low;
+                const int right = value / VALUE_OFFSET;
+                const int down = value % VALUE_OFFSET;
+                if(right > MAX_CLUE)
+                    return nullptr;
+                if(c > 0 && r > 0)
+                    pBoard->setCellType(c, r, CellType::CellClue);
+                pBoard->setClueRight(c, r, right);
+                pBoard->setClueDown(c, r, down);
+                zeroRight[c + r * cols] = right == 0;
+                zeroDown[c + r * cols] = down == 0;
+            }
+                break;
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    // no clue is closed where no answer cell follows, otherwise still to be filled in
+    for(int r = 0; r < static_cast<int>(rows); ++r) {
+        for(int c = 0; c < static_cast<int>(cols); ++c) {
+            const int i = c + r * cols;
+            if(zeroRight[i] && (c+1 == static_cast<int>(cols)
+                                || pBoard->getCellType(c+1, r) == CellType::CellClue))
+                pBoard->setClueRight(c, r, CLOSED_CLUE);
+            if(zeroDown[i] && (r+1 == static_cast<int>(rows)
+                               || pBoard->getCellType(c, r+1) == CellType::CellClue))
+                pBoard->setClueDown(c, r, CLOSED_CLUE);
+        }
+    }
+    return pBoard;
+}
+
+static std::shared_ptr<MetaData> readMeta(const QByteArray &buffer, int &pos)
+{
+    // files written by other tools end after the cells
+    if(pos == buffer.size())
+        return std::make_shared<MetaData>(QString(), 0, 0, 0, 0);
+
+    if(buffer.size() - pos < static_cast<int>(sizeof(META_TAG))
+            || std::memcmp(buffer.constData() + pos, META_TAG, sizeof(META_TAG)) != 0)
+        return nullptr;
+    pos += sizeof(META_TAG);
+
+    quint32 authorSize;
+    if(!getInt(buffer, pos, 2, authorSize) || pos + static_cast<int>(authorSize) > buffer.size())
+        return nullptr;
+    const QString author{QString::fromUtf8(buffer.constData() + pos, authorSize)};
+    pos += authorSize;
+
+    quint32 times[NUM_TIMES];
+    for(int i = 0; i < NUM_TIMES; ++i)
+        if(!getInt(buffer, pos, 4, times[i]))
+            return nullptr;
+    return std::make_shared<MetaData>(author, times[0], times[1], times[2], times[3]);
+}
+
+BoardFile loadBoardFile(const QString &fileName)
+{
+    BoardFile result;
+
+    QFile f{fileName};
+    if(!f.open(QIODevice::ReadOnly))
+        return result;
+    const QByteArray buffer{f.readAll()};
+    if(buffer.size() < static_cast<int>(sizeof(HEADER))
+            || std::memcmp(buffer.constData(), HEADER, sizeof(HEADER)) != 0)
+        return result;
+
+    int pos = sizeof(HEADER);
+    std::shared_ptr<BoardData> pBoard{readCells(buffer, pos)};
+    if(pBoard == nullptr)
+        return result;
+    std::shared_ptr<MetaData> pMeta{readMeta(buffer, pos)};
+    if(pMeta == nullptr)
+        return result;
+
+    result.pBoard = pBoard;
+    result.pMeta = pMeta;
+    return result;
+}
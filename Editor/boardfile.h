@@ -0,0 +1,32 @@
+#ifndef BOARDFILE_H
+#define BOARDFILE_H
+
+#include <QString>
+#include <memory>
+#include <vector>
+#include "boarddata.h"
+#include "metadata.h"
+
+/*
+ * Problem files of the editor
+ * Version 1 .kkr as read by the player, followed by the meta data:
+ *   "KKRM", author (2 byte length + UTF-8), 4 target times (4 bytes each)
+ * All numbers are big endian. The player stops reading after the cells, so
+ * the meta data does not get in its way.
+ * Unfinished boards are saved too: empty answers are stored as 0, closed
+ * and empty clues both as 0 and told apart by the layout when read.
+ * Both functions only touch their arguments; they may run on any thread.
+ */
+bool saveBoardFile(const QString &fileName, const BoardData &board, const MetaData &meta);
+    // written to a temporary file and renamed over fileName once complete,
+    // so a failed save leaves the old file intact
+
+struct BoardFile {
+    std::shared_ptr<const BoardData> pBoard;
+    std::shared_ptr<const MetaData> pMeta;
+};
+
+BoardFile loadBoardFile(const QString &fileName);
+    // both null if the file cannot be read; files without meta data get the defaults
+
+#endif // BOARDFILE_H
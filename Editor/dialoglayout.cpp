@@ -0,0 +1,56 @@
+#include "dialoglayout.h"
+#include <QVBoxLayout>
+#include <QFormLayout>
+#include <QLabel>
+#include <QPushButton>
+
+DialogLayout::DialogLayout(bool square, QWidget *parent)
+    : QDialog(parent)
+    , m_pDensity(nullptr)
+    , m_pSymmetry(nullptr)
+{
+    m_pDensity = new QSpinBox;
+    m_pDensity->setMinimum(MIN_DENSITY);
+    m_pDensity->setMaximum(MAX_DENSITY);
+    m_pDensity->setValue(DEFAULT_DENSITY);
+    m_pDensity->setSuffix("%");
+
+    // same order as LayoutGenerator::Symmetry
+    m_pSymmetry = new QComboBox;
+    m_pSymmetry->addItem(tr("None"));
+    m_pSymmetry->addItem(tr("Point"));
+    if(square)
+        m_pSymmetry->addItem(tr("Rotational"));
+    m_pSymmetry->setCurrentIndex(1);
+
+    // label
+    QVBoxLayout *pVbl = new QVBoxLayout;
+    QLabel *pLbl = new QLabel(tr("Random layout of the whole board:"));
+    pLbl->setAlignment(Qt::AlignLeft);
+    pVbl->addWidget(pLbl);
+
+    // input fields
+    QFormLayout *pForm = new QFormLayout;
+    pForm->addRow(tr("Clue cells:"), m_pDensity);
+    pForm->addRow(tr("Symmetry:"), m_pSymmetry);
+    pVbl->addLayout(pForm);
+
+    // Blank
+    pVbl->addSpacing(20);
+    pVbl->addStretch();
+
+    // buttons
+    QHBoxLayout *pHbl = new QHBoxLayout;
+    QPushButton *pBtnGenerate = new QPushButton{tr("Generate")};
+    QPushButton *pBtnCancel = new QPushButton{tr("Cancel")};
+    pHbl->addStretch();
+    pHbl->addWidget(pBtnGenerate);
+    pHbl->addWidget(pBtnCancel);
+    pVbl->addLayout(pHbl);
+
+    connect(pBtnGenerate, &QPushButton::clicked, this, &QDialog::accept);
+    connect(pBtnCancel, &QPushButton::clicked, this, &QDialog::reject);
+
+    setLayout(pVbl);
+    setWindowTitle(tr("Kakuro Layout"));
+}
@@ -0,0 +1,31 @@
+#ifndef DIALOGLAYOUT_H
+#define DIALOGLAYOUT_H
+
+#include <QDialog>
+#include <QSpinBox>
+#include <QComboBox>
+#include "layoutgenerator.h"
+
+class DialogLayout : public QDialog
+{
+    Q_OBJECT
+    QSpinBox *m_pDensity;
+    QComboBox *m_pSymmetry;
+
+    const static int MIN_DENSITY = 10;
+    const static int MAX_DENSITY = 50;
+    const static int DEFAULT_DENSITY = 25;
+
+public:
+    explicit DialogLayout(bool square, QWidget *parent = nullptr);
+        // rotational symmetry is offered for square boards only
+
+    DialogLayout(const DialogLayout &) = delete;
+    DialogLayout &operator=(const DialogLayout &) = delete;
+
+    int getDensity() const {return m_pDensity->value();}
+    LayoutGenerator::Symmetry getSymmetry() const
+        {return static_cast<LayoutGenerator::Symmetry>(m_pSymmetry->currentIndex());}
+};
+
+#endif // DIALOGLAYOUT_H
@@ -0,0 +1,72 @@
+#include "dialogresize.h"
+#include <QVBoxLayout>
+#include <QGridLayout>
+
+DialogResize::DialogResize(int cols, int rows, QWidget *parent)
+    : QDialog(parent)
+    , m_pLeft(nullptr)
+    , m_pTop(nullptr)
+    , m_pRight(nullptr)
+    , m_pBottom(nullptr)
+    , m_pSize(nullptr)
+    , m_pBtnResize(nullptr)
+    , m_cols(cols)
+    , m_rows(rows)
+{
+    m_pLeft = new QSpinBox;
+    m_pTop = new QSpinBox;
+    m_pRight = new QSpinBox;
+    m_pBottom = new QSpinBox;
+    for(QSpinBox *pSpin : {m_pLeft, m_pTop, m_pRight, m_pBottom}) {
+        pSpin->setMinimum(-MAX_CELLS);
+        pSpin->setMaximum(MAX_CELLS);
+        connect(pSpin, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+                this, &DialogResize::updateSize);
+    }
+
+    // label
+    QVBoxLayout *pVbl = new QVBoxLayout;
+    QLabel *pLbl = new QLabel(tr("Cells to add (negative to remove):"));
+    pLbl->setAlignment(Qt::AlignLeft);
+    pVbl->addWidget(pLbl);
+
+    // input fields around the board
+    QGridLayout *pGrid = new QGridLayout;
+    pGrid->addWidget(m_pTop, 0, 1);
+    pGrid->addWidget(m_pLeft, 1, 0);
+    m_pSize = new QLabel;
+    m_pSize->setAlignment(Qt::AlignCenter);
+    pGrid->addWidget(m_pSize, 1, 1);
+    pGrid->addWidget(m_pRight, 1, 2);
+    pGrid->addWidget(m_pBottom, 2, 1);
+    pVbl->addLayout(pGrid);
+
+    // Blank
+    pVbl->addSpacing(20);
+    pVbl->addStretch();
+
+    // buttons
+    QHBoxLayout *pHbl = new QHBoxLayout;
+    m_pBtnResize = new QPushButton{tr("Resize")};
+    QPushButton *pBtnCancel = new QPushButton{tr("Cancel")};
+    pHbl->addStretch();
+    pHbl->addWidget(m_pBtnResize);
+    pHbl->addWidget(pBtnCancel);
+    pVbl->addLayout(pHbl);
+
+    connect(m_pBtnResize, &QPushButton::clicked, this, &QDialog::accept);
+    connect(pBtnCancel, &QPushButton::clicked, this, &QDialog::reject);
+
+    setLayout(pVbl);
+    setWindowTitle(tr("Kakuro Resize"));
+    updateSize();
+}
+
+void DialogResize::updateSize()
+{
+    const int cols = m_cols + getLeft() + getRight();
+    const int rows = m_rows + getTop() + getBottom();
+    m_pSize->setText(QString("%1 X %2").arg(cols).arg(rows));
+    m_pBtnResize->setEnabled(MIN_CELLS <= cols && cols <= MAX_CELLS
+                             && MIN_CELLS <= rows && rows <= MAX_CELLS);
+}
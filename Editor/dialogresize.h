@@ -0,0 +1,41 @@
+#ifndef DIALOGRESIZE_H
+#define DIALOGRESIZE_H
+
+#include <QDialog>
+#include <QSpinBox>
+#include <QLabel>
+#include <QPushButton>
+
+class DialogResize : public QDialog
+{
+    Q_OBJECT
+    // cells added to each side; negative to remove
+    QSpinBox *m_pLeft;
+    QSpinBox *m_pTop;
+    QSpinBox *m_pRight;
+    QSpinBox *m_pBottom;
+    QLabel *m_pSize;
+    QPushButton *m_pBtnResize;
+
+    // current size; same UI size as DialogNew
+    const int m_cols;
+    const int m_rows;
+
+    const static int MIN_CELLS = 2;
+    const static int MAX_CELLS = 1000;
+
+    void updateSize();
+
+public:
+    DialogResize(int cols, int rows, QWidget *parent = nullptr);
+
+    DialogResize(const DialogResize &) = delete;
+    DialogResize &operator=(const DialogResize &) = delete;
+
+    int getLeft() const {return m_pLeft->value();}
+    int getTop() const {return m_pTop->value();}
+    int getRight() const {return m_pRight->value();}
+    int getBottom() const {return m_pBottom->value();}
+};
+
+#endif // DIALOGRESIZE_H
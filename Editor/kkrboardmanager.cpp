@@ -1,5 +1,7 @@
 #include "kkrboardmanager.h"
 #include <QtGlobal>
+#include <utility>
+#include <algorithm>
 
 BoardData::BoardData(int cols, int rows)
     : m_cols(cols)
@@ -9,23 +11,26 @@ BoardData::BoardData(int cols, int rows)
     // topmost row
     for(int c = 0; c < m_cols; ++c) {
         const int i = c2i(c, 0);
-        m_data[i].ctype = CellType::CellClue;
-        m_data[i].clueRight = m_data[i].clueDown = EMPTY_CLUE;
+        Cell &cell = m_data.modify(i);
+        cell.ctype = CellType::CellClue;
+        cell.clueRight = cell.clueDown = EMPTY_CLUE;
     }
 
     // leftmost column
     for(int r = 1; r < m_rows; ++r) {
         const int i = c2i(0, r);
-        m_data[i].ctype = CellType::CellClue;
-        m_data[i].clueRight = m_data[i].clueDown = EMPTY_CLUE;
+        Cell &cell = m_data.modify(i);
+        cell.ctype = CellType::CellClue;
+        cell.clueRight = cell.clueDown = EMPTY_CLUE;
     }
 
     // everything else
     for(int c = 1; c < m_cols; ++c) {
         for(int r = 1; r < m_rows; ++r) {
             const int i = c2i(c, r);
-            m_data[i].ctype = CellType::CellAnswer;
-            m_data[i].answer = EMPTY_ANSWER;
+            Cell &cell = m_data.modify(i);
+            cell.ctype = CellType::CellAnswer;
+            cell.answer = EMPTY_ANSWER;
         }
     }
 }
@@ -37,6 +42,13 @@ BoardData::BoardData(const BoardData &rhs)
 {
 }
 
+BoardData::BoardData(int cols, int rows, const CellStore &cells)
+    : m_cols(cols)
+    , m_rows(rows)
+    , m_data(cells)
+{
+}
+
 BoardData::~BoardData()
 {
 }
@@ -56,13 +68,14 @@ void BoardData::setCellType(int col, int row, CellType ct)
 
     const int i = c2i(col,row);
     if(m_data[i].ctype != ct) {
-        m_data[i].ctype = ct;
+        Cell &cell = m_data.modify(i);
+        cell.ctype = ct;
         switch(ct) {
         case CellType::CellAnswer:
-            m_data[i].answer = EMPTY_ANSWER;
+            cell.answer = EMPTY_ANSWER;
             break;
         default:
-            m_data[i].clueRight = m_data[i].clueDown = EMPTY_CLUE;
+            cell.clueRight = cell.clueDown = EMPTY_CLUE;
             break;
         }
     }
@@ -82,11 +95,11 @@ void BoardData::setClueRight(int col, int row, int clue)
 {
     Q_ASSERT(0 <= col && col < m_cols);
     Q_ASSERT(0 <= row && row < m_rows);
-    Q_ASSERT(0 <= clue && clue <= 45);
+    Q_ASSERT(CLOSED_CLUE <= clue && clue <= 45);
 
     const int i = c2i(col,row);
     Q_ASSERT(m_data[i].ctype == CellType::CellClue);
-    m_data[i].clueRight = clue;
+    m_data.modify(i).clueRight = clue;
 }
 
 int BoardData::getClueDown(int col, int row) const
@@ -103,11 +116,11 @@ void BoardData::setClueDown(int col, int row, int clue)
 {
     Q_ASSERT(0 <= col && col < m_cols);
     Q_ASSERT(0 <= row && row < m_rows);
-    Q_ASSERT(0 <= clue && clue <= 45);
+    Q_ASSERT(CLOSED_CLUE <= clue && clue <= 45);
 
     const int i = c2i(col,row);
     Q_ASSERT(m_data[i].ctype == CellType::CellClue);
-    m_data[i].clueDown = clue;
+    m_data.modify(i).clueDown = clue;
 }
 
 int BoardData::getAnswer(int col, int row) const
@@ -128,16 +141,389 @@ void BoardData::setAnswer(int col, int row, int ans)
 
     const int i = c2i(col,row);
     Q_ASSERT(m_data[i].ctype == CellType::CellAnswer);
-    m_data[i].answer = ans;
+    m_data.modify(i).answer = ans;
 }
 
 KkrBoardManager::KkrBoardManager(QObject *parent)
     : QObject(parent)
     , m_cols(0)
     , m_rows(0)
+    , m_numIncomplete(0)
+    , m_numBadFrame(0)
+    , m_validityChanged(false)
+    , m_autoClues(false)
+    , m_numUndoCells(0)
+    , m_editDepth(0)
+    , m_replaying(false)
+    , m_cluesChanged(false)
+    , m_edited(false)
+    , m_undoChanged(false)
+{
+}
+
+/*
+ * validation
+ */
+namespace {
+bool isDigit(int ans) {return 1 <= ans && ans <= 9;}
+}
+
+int KkrBoardManager::runBefore(int col, int row, int dir) const
+{
+    if(dir == 0) {
+        if(col == 0)
+            return -1;
+        --col;
+    } else {
+        if(row == 0)
+            return -1;
+        --row;
+    }
+    const int i = c2i(col, row);
+    if(m_data[i].ctype == CellType::CellClue)
+        return i*2 + dir;
+    return m_heads[i*2 + dir];
+}
+
+int KkrBoardManager::runClue(int id) const
+{
+    const Cell &head = m_data[id/2];
+    Q_ASSERT(head.ctype == CellType::CellClue);
+    return id%2 == 0 ? head.clueRight : head.clueDown;
+}
+
+void KkrBoardManager::addDigit(int id, int ans)
+{
+    RunState &rs = m_runs[id];
+    if(!isDigit(ans)) {
+        ++rs.numEmpty;
+        return;
+    }
+    rs.sum += ans;
+    if(++rs.count[ans] > 1) {
+        ++rs.numDup;
+        // the first entry of the digit turns invalid too
+        if(rs.count[ans] == 2) {
+            m_validityChanged = true;
+            markRunDirty(id);
+        }
+    }
+}
+
+void KkrBoardManager::removeDigit(int id, int ans)
+{
+    RunState &rs = m_runs[id];
+    if(!isDigit(ans)) {
+        --rs.numEmpty;
+        return;
+    }
+    rs.sum -= ans;
+    if(--rs.count[ans] > 0) {
+        --rs.numDup;
+        if(rs.count[ans] == 1) {
+            m_validityChanged = true;
+            markRunDirty(id);
+        }
+    }
+}
+
+void KkrBoardManager::linkRun(int col, int row, int dir, int id)
+{
+    while(col < m_cols && row < m_rows) {
+        const int i = c2i(col, row);
+        if(m_data[i].ctype == CellType::CellClue)
+            break;
+        m_heads[i*2 + dir] = id;
+        if(id >= 0) {
+            ++m_runs[id].length;
+            addDigit(id, m_data[i].answer);
+        }
+        if(dir == 0)
+            ++col;
+        else
+            ++row;
+    }
+}
+
+void KkrBoardManager::clearRun(int id)
+{
+    RunState &rs = m_runs[id];
+    // the cells leaving the run
+    if(rs.length > 0 || rs.error)
+        markRunDirty(id);
+    if(rs.error) {
+        m_invalidRuns.erase(id);
+        m_validityChanged = true;
+    }
+    if(rs.incomplete) {
+        --m_numIncomplete;
+        m_validityChanged = true;
+    }
+    rs = RunState();
+}
+
+void KkrBoardManager::buildRun(int id)
+{
+    clearRun(id);
+    const int col = (id/2) % m_cols;
+    const int row = (id/2) / m_cols;
+    const int dir = id%2;
+    linkRun(dir == 0 ? col+1 : col, dir == 0 ? row : row+1, dir, id);
+    // the cells joining the run; O(1), the run was walked above anyway
+    if(m_runs[id].length > 0)
+        markRunDirty(id);
+    refreshRun(id);
+}
+
+void KkrBoardManager::refreshRun(int id)
+{
+    RunState &rs = m_runs[id];
+    const int clue = runClue(id);
+    const bool hasClue = 1 <= clue && clue <= 45;
+
+    bool error;
+    bool incomplete;
+    if(rs.length == 0) {
+        error = hasClue;
+        incomplete = false;
+    } else {
+        // sum of distinct digits: 1+2+...+length to 9+8+...
+        const int minSum = rs.length * (rs.length+1) / 2;
+        const int maxSum = rs.length * (19-rs.length) / 2;
+        incomplete = !hasClue;
+        error = rs.length > 9 || rs.numDup > 0
+                || (hasClue && (clue < minSum || clue > maxSum || rs.sum > clue
+                                || (rs.numEmpty == 0 && rs.sum != clue)));
+    }
+
+    if(error != rs.error) {
+        if(error)
+            m_invalidRuns.insert(id);
+        else
+            m_invalidRuns.erase(id);
+        rs.error = error;
+        m_validityChanged = true;
+        markRunDirty(id);
+    }
+    if(incomplete != rs.incomplete) {
+        m_numIncomplete += incomplete ? 1 : -1;
+        rs.incomplete = incomplete;
+        m_validityChanged = true;
+    }
+}
+
+void KkrBoardManager::markRunDirty(int id)
 {
+    const int col = (id/2) % m_cols;
+    const int row = (id/2) / m_cols;
+    const int length = m_runs[id].length;
+    if(id%2 == 0)
+        m_dirty |= QRect(col, row, length+1, 1);
+    else
+        m_dirty |= QRect(col, row, 1, length+1);
 }
 
+void KkrBoardManager::rebuildValidation()
+{
+    const int numCells = m_cols * m_rows;
+    m_runs.assign(numCells*2, RunState());
+    m_heads.assign(numCells*2, -1);
+    m_invalidRuns.clear();
+    m_numIncomplete = 0;
+    m_numBadFrame = 0;
+
+    for(int r = 0; r < m_rows; ++r) {
+        for(int c = 0; c < m_cols; ++c) {
+            const int i = c2i(c, r);
+            if(m_data[i].ctype == CellType::CellClue) {
+                buildRun(i*2);
+                buildRun(i*2 + 1);
+            } else {
+                if(!isDigit(m_data[i].answer))
+                    ++m_numIncomplete;
+                if(c == 0 || r == 0)
+                    ++m_numBadFrame;
+            }
+        }
+    }
+    m_validityChanged = true;
+}
+
+void KkrBoardManager::notifyValidity()
+{
+    if(m_validityChanged) {
+        m_validityChanged = false;
+        emit sigValidityChanged();
+    }
+}
+
+/*
+ * clues from the answers
+ */
+void KkrBoardManager::deriveClue(int id)
+{
+    // the run state already has the sum
+    const RunState &rs = m_runs[id];
+    if(rs.length == 0 || rs.numEmpty > 0 || rs.sum < 1 || rs.sum > 45)
+        return;
+
+    const int i = id/2;
+    if(id%2 == 0)
+        setClueRight(i % m_cols, i / m_cols, rs.sum);
+    else
+        setClueDown(i % m_cols, i / m_cols, rs.sum);
+}
+
+/*
+ * undo
+ */
+namespace {
+bool sameCell(const Cell &a, const Cell &b)
+{
+    if(a.ctype != b.ctype)
+        return false;
+    if(a.ctype == CellType::CellAnswer)
+        return a.answer == b.answer;
+    return a.clueRight == b.clueRight && a.clueDown == b.clueDown;
+}
+}
+
+void KkrBoardManager::beginEdit()
+{
+    ++m_editDepth;
+}
+
+void KkrBoardManager::endEdit()
+{
+    Q_ASSERT(m_editDepth > 0);
+    if(--m_editDepth > 0)
+        return;
+
+    if(!m_pending.empty()) {
+        // cells changed back and forth within the edit are left out
+        UndoEntry entry;
+        entry.reserve(m_pending.size());
+        for(auto &change : m_pending) {
+            change.after = m_data[change.index];
+            if(!sameCell(change.before, change.after))
+                entry.push_back(change);
+        }
+        m_pending.clear();
+        m_pendingPos.clear();
+
+        if(!entry.empty()) {
+            m_numUndoCells += static_cast<int>(entry.size());
+            m_undo.push_back(std::move(entry));
+            for(const auto &e : m_redo)
+                m_numUndoCells -= static_cast<int>(e.size());
+            m_redo.clear();
+            trimUndo();
+            m_undoChanged = true;
+        }
+    }
+    notifyEdits();
+}
+
+void KkrBoardManager::record(int i)
+{
+    m_dirty |= QRect(i % m_cols, i / m_cols, 1, 1);
+    if(m_replaying)
+        return;
+    Q_ASSERT(m_editDepth > 0);
+    if(m_pendingPos.count(i) > 0)
+        return;
+    m_pendingPos[i] = static_cast<int>(m_pending.size());
+    CellChange change;
+    change.index = i;
+    change.before = m_data[i];
+    m_pending.push_back(change);
+}
+
+void KkrBoardManager::replay(const UndoEntry &entry, bool undo)
+{
+    const EditGroup group{this};
+    m_replaying = true;
+
+    // setCellType() overwrites the clues on its left and above; those not in
+    // the entry keep their current values
+    std::vector<std::pair<int, Cell>> targets;
+    targets.reserve(entry.size() * 3);
+    for(const auto &change : entry) {
+        const Cell &target = undo ? change.before : change.after;
+        if(m_data[change.index].ctype == target.ctype)
+            continue;
+        const int col = change.index % m_cols;
+        const int row = change.index / m_cols;
+        if(col > 0)
+            targets.push_back(std::make_pair(change.index - 1, m_data[change.index - 1]));
+        if(row > 0)
+            targets.push_back(std::make_pair(change.index - m_cols, m_data[change.index - m_cols]));
+    }
+    for(const auto &change : entry)
+        targets.push_back(std::make_pair(change.index, undo ? change.before : change.after));
+
+    // cell types first, then the values; later targets win
+    for(const auto &change : entry) {
+        const Cell &target = undo ? change.before : change.after;
+        setCellType(change.index % m_cols, change.index / m_cols, target.ctype);
+    }
+    for(const auto &target : targets) {
+        const int col = target.first % m_cols;
+        const int row = target.first / m_cols;
+        const Cell &cell = target.second;
+        if(cell.ctype != m_data[target.first].ctype)
+            continue;
+        if(cell.ctype == CellType::CellAnswer) {
+            setAnswer(col, row, cell.answer);
+        } else {
+            setClueRight(col, row, cell.clueRight);
+            setClueDown(col, row, cell.clueDown);
+        }
+    }
+
+    m_replaying = false;
+}
+
+void KkrBoardManager::trimUndo()
+{
+    while(!m_undo.empty()
+          && (static_cast<int>(m_undo.size()) > MAX_UNDO_ENTRIES || m_numUndoCells > MAX_UNDO_CELLS)) {
+        m_numUndoCells -= static_cast<int>(m_undo.front().size());
+        m_undo.pop_front();
+    }
+}
+
+void KkrBoardManager::clearUndo()
+{
+    m_undo.clear();
+    m_redo.clear();
+    m_numUndoCells = 0;
+    m_undoChanged = true;
+}
+
+void KkrBoardManager::notifyEdits()
+{
+    notifyValidity();
+    if(m_cluesChanged) {
+        m_cluesChanged = false;
+        emit sigCluesChanged();
+    }
+    const QRect dirty{m_dirty};
+    m_dirty = QRect();
+    if(m_edited) {
+        m_edited = false;
+        emit sigEdited(dirty);
+    }
+    if(m_undoChanged) {
+        m_undoChanged = false;
+        emit sigUndoChanged();
+    }
+}
+
+/*
+ * edit
+ */
+
 void KkrBoardManager::setCellType(int col, int row, CellType ct)
 {
     Q_ASSERT(0 <= col && col < m_cols);
@@ -145,29 +531,76 @@ void KkrBoardManager::setCellType(int col, int row, CellType ct)
 
     const int i = c2i(col,row);
     if(m_data[i].ctype != ct) {
-        m_data[i].ctype = ct;
+        const EditGroup group{this};
+        record(i);
+        if(col > 0 && m_data[c2i(col-1,row)].ctype == CellType::CellClue)
+            record(c2i(col-1,row));
+        if(row > 0 && m_data[c2i(col,row-1)].ctype == CellType::CellClue)
+            record(c2i(col,row-1));
+
+        const bool onFrame = col == 0 || row == 0;
+        if(m_data[i].ctype == CellType::CellAnswer) {
+            if(!isDigit(m_data[i].answer))
+                --m_numIncomplete;
+            if(onFrame)
+                --m_numBadFrame;
+        }
+
+        Cell &cell = m_data.modify(i);
+        cell.ctype = ct;
         if(ct == CellType::CellAnswer)
-            m_data[i].answer = EMPTY_ANSWER;
+            cell.answer = EMPTY_ANSWER;
         else {
             if(col == m_cols-1 || m_data[c2i(col+1, row)].ctype == CellType::CellClue)
-                m_data[i].clueRight = CLOSED_CLUE;
+                cell.clueRight = CLOSED_CLUE;
             else
-                m_data[i].clueRight = EMPTY_CLUE;
+                cell.clueRight = EMPTY_CLUE;
             if(row == m_rows-1 || m_data[c2i(col, row+1)].ctype == CellType::CellClue)
-                m_data[i].clueDown = CLOSED_CLUE;
+                cell.clueDown = CLOSED_CLUE;
             else
-                m_data[i].clueDown = EMPTY_CLUE;
+                cell.clueDown = EMPTY_CLUE;
         }
         if(col > 0) {
             const int il = c2i(col-1,row);
             if(m_data[il].ctype == CellType::CellClue) {
-                m_data[il].clueRight = (ct == CellType::CellAnswer ? EMPTY_CLUE : CLOSED_CLUE);
+                m_data.modify(il).clueRight = (ct == CellType::CellAnswer ? EMPTY_CLUE : CLOSED_CLUE);
             }
         }
         if(row > 0) {
             const int iu = c2i(col,row-1);
             if(m_data[iu].ctype == CellType::CellClue) {
-                m_data[iu].clueDown = (ct == CellType::CellAnswer ? EMPTY_CLUE : CLOSED_CLUE);
+                m_data.modify(iu).clueDown = (ct == CellType::CellAnswer ? EMPTY_CLUE : CLOSED_CLUE);
+            }
+        }
+
+        // the runs before the cell end or go through it now; its own runs start or go away
+        for(int dir = 0; dir < 2; ++dir) {
+            const int prev = runBefore(col, row, dir);
+            if(prev >= 0)
+                buildRun(prev);
+            else if(ct == CellType::CellAnswer)
+                linkRun(col, row, dir, -1);
+            if(ct == CellType::CellClue)
+                buildRun(i*2 + dir);
+            else
+                clearRun(i*2 + dir);
+        }
+        if(ct == CellType::CellAnswer) {
+            ++m_numIncomplete;
+            if(onFrame)
+                ++m_numBadFrame;
+        }
+        m_validityChanged = true;
+        m_cluesChanged = true;
+        m_edited = true;
+
+        if(m_autoClues && !m_replaying) {
+            for(int dir = 0; dir < 2; ++dir) {
+                const int prev = runBefore(col, row, dir);
+                if(prev >= 0)
+                    deriveClue(prev);
+                if(ct == CellType::CellClue)
+                    deriveClue(i*2 + dir);
             }
         }
     }
@@ -180,7 +613,15 @@ void KkrBoardManager::setClueRight(int col, int row, int clue)
 
     const int i = c2i(col,row);
     Q_ASSERT(m_data[i].ctype == CellType::CellClue);
-    m_data[i].clueRight = clue;
+    if(m_data[i].clueRight == clue)
+        return;
+    const EditGroup group{this};
+    record(i);
+    m_data.modify(i).clueRight = clue;
+
+    refreshRun(i*2);
+    m_cluesChanged = true;
+    m_edited = true;
 }
 
 void KkrBoardManager::setClueDown(int col, int row, int clue)
@@ -190,7 +631,15 @@ void KkrBoardManager::setClueDown(int col, int row, int clue)
 
     const int i = c2i(col,row);
     Q_ASSERT(m_data[i].ctype == CellType::CellClue);
-    m_data[i].clueDown = clue;
+    if(m_data[i].clueDown == clue)
+        return;
+    const EditGroup group{this};
+    record(i);
+    m_data.modify(i).clueDown = clue;
+
+    refreshRun(i*2 + 1);
+    m_cluesChanged = true;
+    m_edited = true;
 }
 
 void KkrBoardManager::setAnswer(int col, int row, int ans)
@@ -200,7 +649,280 @@ void KkrBoardManager::setAnswer(int col, int row, int ans)
 
     const int i = c2i(col,row);
     Q_ASSERT(m_data[i].ctype == CellType::CellAnswer);
-    m_data[i].answer = ans;
+    const int old = m_data[i].answer;
+    if(old == ans)
+        return;
+    const EditGroup group{this};
+    record(i);
+    m_data.modify(i).answer = ans;
+
+    for(int dir = 0; dir < 2; ++dir) {
+        const int id = m_heads[i*2 + dir];
+        if(id < 0)
+            continue;
+        removeDigit(id, old);
+        addDigit(id, ans);
+        refreshRun(id);
+    }
+    if(isDigit(old) != isDigit(ans)) {
+        m_numIncomplete += isDigit(ans) ? -1 : 1;
+        m_validityChanged = true;
+    }
+    m_edited = true;
+
+    if(m_autoClues && !m_replaying) {
+        for(int dir = 0; dir < 2; ++dir)
+            if(m_heads[i*2 + dir] >= 0)
+                deriveClue(m_heads[i*2 + dir]);
+    }
+}
+
+/*
+ * bulk edits
+ */
+namespace {
+Cell emptyCell(CellType ct)
+{
+    Cell cell;
+    cell.ctype = ct;
+    if(ct == CellType::CellAnswer) {
+        cell.answer = EMPTY_ANSWER;
+    } else {
+        cell.clueRight = EMPTY_CLUE;
+        cell.clueDown = EMPTY_CLUE;
+    }
+    return cell;
+}
+}
+
+void KkrBoardManager::writeCells(const QRect &area, const std::vector<Cell> &cells)
+{
+    Q_ASSERT(QRect(0, 0, m_cols, m_rows).contains(area));
+    Q_ASSERT(static_cast<int>(cells.size()) == area.width() * area.height());
+
+    const EditGroup group{this};
+
+    // the runs of clue cells turning into answer cells go away; the others are rebuilt below
+    for(int r = area.top(); r <= area.bottom(); ++r) {
+        for(int c = area.left(); c <= area.right(); ++c) {
+            const int i = c2i(c, r);
+            if(m_data[i].ctype == CellType::CellClue) {
+                clearRun(i*2);
+                clearRun(i*2 + 1);
+            }
+        }
+    }
+
+    auto src = cells.cbegin();
+    for(int r = area.top(); r <= area.bottom(); ++r) {
+        for(int c = area.left(); c <= area.right(); ++c, ++src) {
+            const bool onFrame = c == 0 || r == 0;
+            const int i = c2i(c, r);
+            if((src->ctype == CellType::CellAnswer && onFrame) || sameCell(m_data[i], *src))
+                continue;
+            record(i);
+            if(m_data[i].ctype == CellType::CellAnswer) {
+                if(!isDigit(m_data[i].answer))
+                    --m_numIncomplete;
+                if(onFrame)
+                    --m_numBadFrame;
+            }
+            m_data.modify(i) = *src;
+            if(src->ctype == CellType::CellAnswer && !isDigit(src->answer))
+                ++m_numIncomplete;
+        }
+    }
+
+    // clues of the area and those on its left and above
+    for(int r = std::max(area.top()-1, 0); r <= area.bottom(); ++r) {
+        for(int c = std::max(area.left()-1, 0); c <= area.right(); ++c) {
+            const int i = c2i(c, r);
+            const Cell &cell = m_data[i];
+            if(cell.ctype != CellType::CellClue)
+                continue;
+            const bool openRight = c < m_cols-1 && m_data[i+1].ctype == CellType::CellAnswer;
+            const bool openDown = r < m_rows-1 && m_data[i+m_cols].ctype == CellType::CellAnswer;
+            const int right = openRight ? (cell.clueRight == CLOSED_CLUE ? EMPTY_CLUE : cell.clueRight)
+                                        : CLOSED_CLUE;
+            const int down = openDown ? (cell.clueDown == CLOSED_CLUE ? EMPTY_CLUE : cell.clueDown)
+                                      : CLOSED_CLUE;
+            if(right != cell.clueRight || down != cell.clueDown) {
+                record(i);
+                Cell &changed = m_data.modify(i);
+                changed.clueRight = right;
+                changed.clueDown = down;
+            }
+        }
+    }
+
+    std::vector<int> rebuilt;
+    for(int r = area.top(); r <= area.bottom(); ++r)
+        relinkLine(area.left(), r, 0, area.width(), rebuilt);
+    for(int c = area.left(); c <= area.right(); ++c)
+        relinkLine(c, area.top(), 1, area.height(), rebuilt);
+
+    m_validityChanged = true;
+    m_cluesChanged = true;
+    m_edited = true;
+
+    if(m_autoClues && !m_replaying) {
+        for(int id : rebuilt)
+            deriveClue(id);
+    }
+}
+
+void KkrBoardManager::relinkLine(int col, int row, int dir, int length, std::vector<int> &rebuilt)
+{
+    const int dc = dir == 0 ? 1 : 0;
+    const int dr = dir == 0 ? 0 : 1;
+
+    // the run coming into the line from before it
+    int c = col;
+    int r = row;
+    while(c-dc >= 0 && r-dr >= 0 && m_data[c2i(c-dc, r-dr)].ctype == CellType::CellAnswer) {
+        c -= dc;
+        r -= dr;
+    }
+    if(c-dc >= 0 && r-dr >= 0) {
+        const int id = c2i(c-dc, r-dr)*2 + dir;
+        buildRun(id);
+        rebuilt.push_back(id);
+    } else if(m_data[c2i(c, r)].ctype == CellType::CellAnswer) {
+        linkRun(c, r, dir, -1);
+    }
+
+    // the runs starting on the line
+    for(int k = 0; k < length; ++k) {
+        const int i = c2i(col + k*dc, row + k*dr);
+        if(m_data[i].ctype == CellType::CellClue) {
+            buildRun(i*2 + dir);
+            rebuilt.push_back(i*2 + dir);
+        }
+    }
+}
+
+KkrBoardManager::CellBlock KkrBoardManager::copyCells(const QRect &area) const
+{
+    Q_ASSERT(QRect(0, 0, m_cols, m_rows).contains(area));
+
+    CellBlock block;
+    block.cols = area.width();
+    block.rows = area.height();
+    block.cells.reserve(block.cols * block.rows);
+    for(int r = area.top(); r <= area.bottom(); ++r)
+        for(int c = area.left(); c <= area.right(); ++c)
+            block.cells.push_back(m_data[c2i(c, r)]);
+    return block;
+}
+
+void KkrBoardManager::fillCellType(const QRect &area, CellType ct)
+{
+    CellBlock block{copyCells(area)};
+    for(auto &cell : block.cells)
+        if(cell.ctype != ct)
+            cell = emptyCell(ct);
+    writeCells(area, block.cells);
+}
+
+void KkrBoardManager::clearCells(const QRect &area)
+{
+    CellBlock block{copyCells(area)};
+    for(auto &cell : block.cells)
+        cell = emptyCell(cell.ctype);
+    writeCells(area, block.cells);
+}
+
+void KkrBoardManager::pasteCells(int col, int row, const CellBlock &block)
+{
+    const QRect area{QRect(col, row, block.cols, block.rows) & QRect(0, 0, m_cols, m_rows)};
+    if(area.isEmpty())
+        return;
+
+    std::vector<Cell> cells;
+    cells.reserve(area.width() * area.height());
+    for(int r = area.top(); r <= area.bottom(); ++r)
+        for(int c = area.left(); c <= area.right(); ++c)
+            cells.push_back(block.cells[(c-col) + (r-row) * block.cols]);
+    writeCells(area, cells);
+}
+
+bool KkrBoardManager::transformCells(const QRect &area, Transform t)
+{
+    const bool quarter = t == Transform::RotateRight || t == Transform::RotateLeft;
+    if(quarter && area.width() != area.height())
+        return false;
+
+    const CellBlock block{copyCells(area)};
+    const int w = block.cols;
+    const int h = block.rows;
+    std::vector<Cell> cells;
+    cells.reserve(w * h);
+    for(int y = 0; y < h; ++y) {
+        for(int x = 0; x < w; ++x) {
+            // source of (x,y)
+            int sx = x;
+            int sy = y;
+            switch(t) {
+            case Transform::MirrorLeftRight:
+                sx = w-1-x;
+                break;
+            case Transform::MirrorTopBottom:
+                sy = h-1-y;
+                break;
+            case Transform::Rotate180:
+                sx = w-1-x;
+                sy = h-1-y;
+                break;
+            case Transform::RotateRight:
+                sx = y;
+                sy = w-1-x;
+                break;
+            case Transform::RotateLeft:
+                sx = h-1-y;
+                sy = x;
+                break;
+            }
+            const Cell &src = block.cells[sx + sy * w];
+            cells.push_back(src.ctype == CellType::CellAnswer ? src : emptyCell(CellType::CellClue));
+        }
+    }
+    writeCells(area, cells);
+    return true;
+}
+
+bool KkrBoardManager::applySymmetry(const QRect &area, Symmetry s)
+{
+    // the topmost row and the leftmost column are out of it
+    const QRect answerArea{1, 1, m_cols-1, m_rows-1};
+    const int w = answerArea.width();
+    const int h = answerArea.height();
+    if(s == Symmetry::Rotational && w != h)
+        return false;
+    const QRect source{area & answerArea};
+    if(source.isEmpty())
+        return true;
+
+    CellBlock block{copyCells(answerArea)};
+    auto setType = [&block](int x, int y, CellType ct) {
+        Cell &cell = block.cells[x + y * block.cols];
+        if(cell.ctype != ct)
+            cell = emptyCell(ct);
+    };
+    for(int r = source.top(); r <= source.bottom(); ++r) {
+        for(int c = source.left(); c <= source.right(); ++c) {
+            // in answer area coord; images already set are read back, so overlaps agree
+            const int x = c-1;
+            const int y = r-1;
+            const CellType ct = block.cells[x + y * w].ctype;
+            setType(w-1-x, h-1-y, ct);
+            if(s == Symmetry::Rotational) {
+                setType(w-1-y, x, ct);
+                setType(y, w-1-x, ct);
+            }
+        }
+    }
+    writeCells(answerArea, block.cells);
+    return true;
 }
 
 CellType KkrBoardManager::getCellType(int col, int row) const
@@ -243,90 +965,36 @@ int KkrBoardManager::getAnswer(int col, int row) const
 
 bool KkrBoardManager::isValid() const
 {
-    // topmost row; must be always clue
-    for(int c = 0; c < m_cols; ++c) {
-        const int i = c2i(c,0);
-        if(m_data[i].ctype != CellType::CellClue)
-            return false;
-    }
+    return m_numBadFrame == 0 && m_numIncomplete == 0 && m_invalidRuns.empty();
+}
 
-    // leftmost column; must be always clue
-    for(int r = 1; r < m_rows; ++r) {
-        const int i = c2i(0,r);
-        if(m_data[i].ctype != CellType::CellClue)
-            return false;
-    }
+bool KkrBoardManager::isCellInvalid(int col, int row) const
+{
+    Q_ASSERT(0 <= col && col < m_cols);
+    Q_ASSERT(0 <= row && row < m_rows);
 
-    // make sure all cells have a value
-    for(int c = 0; c < m_cols; ++c) {
-        for(int r = 0; r < m_rows; ++r) {
-            const int i = c2i(c,r);
-            if(m_data[i].ctype == CellType::CellAnswer) {
-                if(m_data[i].answer < 1 || m_data[i].answer > 9)
-                    return false;
-            } else {
-                const int cr = m_data[i].clueRight;
-                if(cr == EMPTY_CLUE) {
-                    if(c != m_cols-1 && m_data[c2i(c+1,r)].ctype != CellType::CellClue)
-                        return false;
-                } else if(cr < 1 || cr > 45)
-                    return false;
-
-                const int cd = m_data[i].clueDown;
-                if(cd == EMPTY_CLUE) {
-                    if(r != m_rows-1 && m_data[c2i(c,r+1)].ctype != CellType::CellClue)
-                        return false;
-                } else if(cd < 1 || cd > 45)
-                    return false;
-            }
-        }
-    }
+    const int i = c2i(col,row);
+    if(m_data[i].ctype != CellType::CellAnswer)
+        return false;
+    // the topmost row and the leftmost column must be clue cells
+    if(col == 0 || row == 0)
+        return true;
 
-    // make sure clue and sum of answers match
-    // right
-    for(int r = 0; r < m_rows; ++r) {
-        int sum = 0;
-        int clue = 0;
-        for(int c = 0; c < m_cols; ++c) {
-            const int i = c2i(c,r);
-            if(m_data[i].ctype == CellType::CellClue) {
-                if(sum != clue)
-                    return false;
-                sum = 0;
-                clue = m_data[i].clueRight;
-            } else
-                sum += m_data[i].answer;
-        }
-        if(sum != clue)
-            return false;
+    const int ans = m_data[i].answer;
+    if(!isDigit(ans))
+        return false;
+    for(int dir = 0; dir < 2; ++dir) {
+        const int id = m_heads[i*2 + dir];
+        if(id >= 0 && m_runs[id].count[ans] > 1)
+            return true;
     }
-    // down
-    for(int c = 0; c < m_cols; ++c) {
-        int sum = 0;
-        int clue = 0;
-        for(int r = 0; r < m_rows; ++r) {
-            const int i = c2i(c,r);
-            if(m_data[i].ctype == CellType::CellClue) {
-                if(sum != clue)
-                    return false;
-                sum = 0;
-                clue = m_data[i].clueDown;
-            } else
-                sum += m_data[i].answer;
-        }
-        if(sum != clue)
-            return false;
-    }
-    // TODO - need to implement more checks
-    return true;
+    return false;
 }
 
-std::unique_ptr<BoardData> KkrBoardManager::getBoardData() const
+std::shared_ptr<const BoardData> KkrBoardManager::getBoardData() const
 {
-    std::unique_ptr<BoardData> pBdr{new BoardData{m_cols, m_rows}};
-    std::copy(begin(m_data), end(m_data), begin(pBdr->m_data));
-
-    return pBdr;
+    // shares the cells; the chunks edited later are copied then
+    return std::shared_ptr<const BoardData>{new BoardData{m_cols, m_rows, m_data}};
 }
 
 /*
@@ -335,46 +1003,157 @@ std::unique_ptr<BoardData> KkrBoardManager::getBoardData() const
 void KkrBoardManager::slCreate(int cols, int rows)
 {
     m_cols = cols; m_rows = rows;
-    m_data.resize(m_cols*m_rows);
+    m_data = CellStore{m_cols*m_rows};
 
     // top-left cell
-    m_data[0].ctype = CellType::CellClue;
-    m_data[0].clueRight = m_data[0].clueDown = CLOSED_CLUE;
+    Cell &topLeft = m_data.modify(0);
+    topLeft.ctype = CellType::CellClue;
+    topLeft.clueRight = topLeft.clueDown = CLOSED_CLUE;
 
     // topmost row
     for(int c = 1; c < m_cols; ++c) {
-        const int i = c2i(c, 0);
-        m_data[i].ctype = CellType::CellClue;
-        m_data[i].clueRight = CLOSED_CLUE;
-        m_data[i].clueDown = EMPTY_CLUE;
+        Cell &cell = m_data.modify(c2i(c, 0));
+        cell.ctype = CellType::CellClue;
+        cell.clueRight = CLOSED_CLUE;
+        cell.clueDown = EMPTY_CLUE;
     }
 
     // leftmost column
     for(int r = 1; r < m_rows; ++r) {
-        const int i = c2i(0, r);
-        m_data[i].ctype = CellType::CellClue;
-        m_data[i].clueRight = EMPTY_CLUE;
-        m_data[i].clueDown = CLOSED_CLUE;
+        Cell &cell = m_data.modify(c2i(0, r));
+        cell.ctype = CellType::CellClue;
+        cell.clueRight = EMPTY_CLUE;
+        cell.clueDown = CLOSED_CLUE;
     }
 
     // everything else
     for(int c = 1; c < m_cols; ++c) {
         for(int r = 1; r < m_rows; ++r) {
-            const int i = c2i(c, r);
-            m_data[i].ctype = CellType::CellAnswer;
-            m_data[i].answer = EMPTY_ANSWER;
+            Cell &cell = m_data.modify(c2i(c, r));
+            cell.ctype = CellType::CellAnswer;
+            cell.answer = EMPTY_ANSWER;
         }
     }
 
+    rebuildValidation();
+    clearUndo();
     emit sigReset();
+    notifyEdits();
 }
 
 void KkrBoardManager::slRead(std::shared_ptr<const BoardData> data)
 {
     m_cols = data->getNumCols();
     m_rows = data->getNumRows();
-    m_data.resize(data->m_data.size());
-    std::copy(begin(data->m_data), end(data->m_data), begin(m_data));
+    m_data = data->m_data;
 
+    rebuildValidation();
+    clearUndo();
     emit sigReset();
+    notifyEdits();
+}
+
+void KkrBoardManager::slResize(int left, int top, int right, int bottom)
+{
+    const int newCols = m_cols + left + right;
+    const int newRows = m_rows + top + bottom;
+    Q_ASSERT(newCols > 1 && newRows > 1);
+
+    // all cells are moved into the new geometry in one allocation
+    CellStore newData{newCols * newRows};
+    // the old topmost row and leftmost column only stay on the new ones
+    for(int r = 0; r < newRows; ++r) {
+        const int oldRow = r == 0 ? 0 : r - top;
+        const bool rowKept = oldRow == 0 ? r == 0 : 0 < oldRow && oldRow < m_rows;
+        for(int c = 0; c < newCols; ++c) {
+            const int oldCol = c == 0 ? 0 : c - left;
+            const bool colKept = oldCol == 0 ? c == 0 : 0 < oldCol && oldCol < m_cols;
+            Cell &cell = newData.modify(c + r * newCols);
+            if(rowKept && colKept) {
+                cell = m_data[c2i(oldCol, oldRow)];
+            } else if(c == 0 || r == 0) {
+                cell.ctype = CellType::CellClue;
+                cell.clueRight = cell.clueDown = EMPTY_CLUE;
+            } else {
+                cell.ctype = CellType::CellAnswer;
+                cell.answer = EMPTY_ANSWER;
+            }
+        }
+    }
+    m_cols = newCols;
+    m_rows = newRows;
+    m_data = std::move(newData);
+
+    // runs cut at the new edges or running into new cells
+    for(int r = 0; r < m_rows; ++r) {
+        for(int c = 0; c < m_cols; ++c) {
+            if(m_data[c2i(c, r)].ctype != CellType::CellClue)
+                continue;
+            Cell &cell = m_data.modify(c2i(c, r));
+            if(c == m_cols-1 || m_data[c2i(c+1, r)].ctype == CellType::CellClue)
+                cell.clueRight = CLOSED_CLUE;
+            else if(cell.clueRight == CLOSED_CLUE)
+                cell.clueRight = EMPTY_CLUE;
+            if(r == m_rows-1 || m_data[c2i(c, r+1)].ctype == CellType::CellClue)
+                cell.clueDown = CLOSED_CLUE;
+            else if(cell.clueDown == CLOSED_CLUE)
+                cell.clueDown = EMPTY_CLUE;
+        }
+    }
+
+    rebuildValidation();
+    clearUndo();
+    m_cluesChanged = true;
+    m_edited = true;
+    emit sigReset();
+    notifyEdits();
+}
+
+void KkrBoardManager::slUndo()
+{
+    if(m_undo.empty())
+        return;
+    UndoEntry entry(std::move(m_undo.back()));
+    m_undo.pop_back();
+    replay(entry, true);
+    m_redo.push_back(std::move(entry));
+    m_undoChanged = true;
+    notifyEdits();
+}
+
+void KkrBoardManager::slRedo()
+{
+    if(m_redo.empty())
+        return;
+    UndoEntry entry(std::move(m_redo.back()));
+    m_redo.pop_back();
+    replay(entry, false);
+    m_undo.push_back(std::move(entry));
+    m_undoChanged = true;
+    notifyEdits();
+}
+
+void KkrBoardManager::slDeriveClues()
+{
+    const EditGroup group{this};
+    for(int i = 0; i < m_cols * m_rows; ++i) {
+        if(m_data[i].ctype == CellType::CellClue) {
+            deriveClue(i*2);
+            deriveClue(i*2 + 1);
+        }
+    }
+}
+
+void KkrBoardManager::slSetAnswers(const std::vector<int> &answers)
+{
+    Q_ASSERT(static_cast<int>(answers.size()) == m_cols * m_rows);
+
+    const EditGroup group{this};
+    for(int row = 0; row < m_rows; ++row) {
+        for(int col = 0; col < m_cols; ++col) {
+            const int i = c2i(col, row);
+            if(m_data[i].ctype == CellType::CellAnswer)
+                setAnswer(col, row, answers[i]);
+        }
+    }
 }
@@ -2,8 +2,14 @@
 #define KKRBOARDMANAGER_H
 
 #include <QObject>
+#include <QRect>
 #include <vector>
+#include <deque>
 #include <memory>
+#include <set>
+#include <array>
+#include <unordered_map>
+#include <cstdint>
 #include "boarddata.h"
 
 class KkrBoardManager : public QObject
@@ -12,16 +18,119 @@ class KkrBoardManager : public QObject
 
     int m_cols;
     int m_rows;
-    std::vector<Cell> m_data;
+    CellStore m_data;
 
     // col,row to index
     int c2i(int c, int r) const {return r*m_cols + c;}
 
+    /*
+     * validation
+     * Each run of answer cells belongs to the clue cell heading it. The state
+     * of every run is kept up to date by the setters below, so checking the
+     * board or a single cell never rescans the grid.
+     */
+    struct RunState {
+        int length;
+        int sum;
+        int numEmpty;
+        int numDup;         // extra entries of digits already in the run
+        std::array<std::uint16_t, 10> count;    // per digit; [0] is unused
+        bool error;
+        bool incomplete;
+    };
+    std::vector<RunState> m_runs;   // by run id
+    std::vector<int> m_heads;       // per cell and direction, run id of an answer cell; -1 if none
+    std::set<int> m_invalidRuns;
+    int m_numIncomplete;            // empty answer cells and runs without a clue
+    int m_numBadFrame;              // answer cells in the topmost row or the leftmost column
+    bool m_validityChanged;
+
+    int runBefore(int col, int row, int dir) const;
+        // run id of the cell before (col,row) in dir; -1 at the board edge
+    int runClue(int id) const;
+    void addDigit(int id, int ans);
+    void removeDigit(int id, int ans);
+    void linkRun(int col, int row, int dir, int id);
+        // assigns the answer cells from (col,row) on to run id and adds their digits
+    void clearRun(int id);
+    void buildRun(int id);
+        // O(run length); the other updates are O(1)
+    void refreshRun(int id);
+    void markRunDirty(int id);
+        // the clue cell and the answer cells of the run, as its marks may change
+    void rebuildValidation();
+    void notifyValidity();
+
+    /*
+     * clues from the answers
+     */
+    bool m_autoClues;
+    void deriveClue(int id);
+        // sum of a complete run; runs with empty cells are left as they are
+
+    /*
+     * undo
+     * An entry holds the cells an edit changed, before and after. Every setter
+     * records the cells it touches, so the neighbouring clues setCellType()
+     * closes or opens are in the same entry. Edits between beginEdit() and
+     * endEdit() make one entry; the signals are sent once at the end.
+     */
+    struct CellChange {
+        int index;
+        Cell before;
+        Cell after;
+    };
+    typedef std::vector<CellChange> UndoEntry;
+    static const int MAX_UNDO_ENTRIES = 1000;
+    static const int MAX_UNDO_CELLS = 1000000;
+        // the oldest entries are dropped beyond either
+    std::deque<UndoEntry> m_undo;
+    std::deque<UndoEntry> m_redo;
+    int m_numUndoCells;                         // in m_undo and m_redo
+    UndoEntry m_pending;                        // edit in progress
+    std::unordered_map<int, int> m_pendingPos;  // cell index -> position in m_pending
+    int m_editDepth;
+    bool m_replaying;
+    bool m_cluesChanged;
+    bool m_edited;
+    bool m_undoChanged;
+    QRect m_dirty;      // bounds of the cells to repaint after the edit, in cell coord
+
+    void beginEdit();
+    void endEdit();
+    void record(int i);
+        // before cell i changes; also marks it dirty
+    void replay(const UndoEntry &entry, bool undo);
+    void trimUndo();
+    void clearUndo();
+    void notifyEdits();
+
+    // groups the setter calls in its scope into one undo entry
+    class EditGroup {
+        KkrBoardManager *m_p;
+    public:
+        explicit EditGroup(KkrBoardManager *p) : m_p(p) {m_p->beginEdit();}
+        ~EditGroup() {m_p->endEdit();}
+        EditGroup(const EditGroup &) = delete;
+        EditGroup &operator=(const EditGroup &) = delete;
+    };
+
     void setCellType(int col, int row, CellType ct);
     void setClueRight(int col, int row, int clue);
     void setClueDown(int col, int row, int clue);
     void setAnswer(int col, int row, int ans);
 
+    /*
+     * bulk edits
+     * The cells of an area are written at once; the runs crossing the area are
+     * relinked once per row and column of it instead of once per cell.
+     */
+    void writeCells(const QRect &area, const std::vector<Cell> &cells);
+        // cells row by row; answer cells are not written to the topmost row or
+        // the leftmost column; clues next to answer cells are opened, others closed
+    void relinkLine(int col, int row, int dir, int length, std::vector<int> &rebuilt);
+        // runs in dir through length cells from (col,row); rebuilt gets their ids
+
 public:
     explicit KkrBoardManager(QObject *parent = 0);
 
@@ -33,16 +142,86 @@ public:
     int getClueDown(int col, int row) const;
     int getAnswer(int col, int row) const;
 
+    enum class RunDir {
+        Right, Down
+    };
+
     bool isValid() const;
+        // every cell filled and no invalid run
+    int getRunId(int col, int row, RunDir dir) const {return c2i(col, row)*2 + static_cast<int>(dir);}
+        // run headed by clue cell (col,row)
+    const std::set<int> &getInvalidRuns() const {return m_invalidRuns;}
+        // runs that cannot be right whatever is entered in the empty cells:
+        // repeated digits, wrong or impossible sums, or a clue without cells
+    bool isRunInvalid(int col, int row, RunDir dir) const {return m_invalidRuns.count(getRunId(col, row, dir)) > 0;}
+    bool isCellInvalid(int col, int row) const;
+        // answer cell whose digit is repeated in its runs, or not in a run at all
+
+    std::shared_ptr<const BoardData> getBoardData() const;
+        // immutable snapshot sharing the cells with the board; cheap
+
+    bool isAutoClues() const {return m_autoClues;}
+    void setAutoClues(bool autoClues) {m_autoClues = autoClues;}
+        // re-derive the clues of the runs an edit changes; not retroactive
+
+    struct CellBlock {
+        int cols;
+        int rows;
+        std::vector<Cell> cells;    // row by row
+    };
+    enum class Transform {
+        MirrorLeftRight, MirrorTopBottom, Rotate180, RotateRight, RotateLeft
+    };
+    enum class Symmetry {
+        Point, Rotational
+    };
+        // about the center of the answer area: by 180 and by 90 degrees
+
+    // the bulk edits below are one undo entry each
+    CellBlock copyCells(const QRect &area) const;
+    void fillCellType(const QRect &area, CellType ct);
+        // cells of the other type become empty ones
+    void clearCells(const QRect &area);
+        // answers and clues to empty
+    void pasteCells(int col, int row, const CellBlock &block);
+        // block's top left at (col,row); clipped to the board
+    bool transformCells(const QRect &area, Transform t);
+        // cell types and answers move; clues are emptied as their runs change
+        // false for the rotations by 90 degrees unless area is square
+    bool applySymmetry(const QRect &area, Symmetry s);
+        // the cell types in area are copied to their images; answers and clues
+        // of the changed cells are emptied
+        // false for Rotational unless the answer area is square
 
-    std::unique_ptr<BoardData> getBoardData() const;
+    bool canUndo() const {return !m_undo.empty();}
+    bool canRedo() const {return !m_redo.empty();}
 
 signals:
     void sigReset();
+    void sigValidityChanged();
+        // isValid(), the invalid runs or the invalid cells may have changed
+    void sigCluesChanged();
+        // a cell type or a clue was edited; answers do not count
+    void sigEdited(const QRect &cells);
+        // any change by the view, undo or redo; cells bounds the changed cells
+        // and those whose validity marks changed (cell coord)
+    void sigUndoChanged();
+        // canUndo() or canRedo() may have changed
 
 public slots:
     void slCreate(int cols, int rows);
     void slRead(std::shared_ptr<const BoardData> data);
+    void slUndo();
+    void slRedo();
+    void slDeriveClues();
+        // every clue from its run; one undo entry
+    void slResize(int left, int top, int right, int bottom);
+        // cells added to (negative: removed from) each side of the answer area;
+        // the topmost row and the leftmost column stay with their clues
+        // the undo history is cleared, as cell indexes change
+    void slSetAnswers(const std::vector<int> &answers);
+        // answers per cell (col + row * numCols) of the current size; clue cells
+        // are skipped; one undo entry
 
 friend class KkrBoardView;
 };
@@ -2,10 +2,17 @@
 #include "kkreditmain.h"
 #include "metadataview.h"
 #include <QMenuBar>
+#include <QStatusBar>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QtConcurrent>
 #include <QDockWidget>
 #include <QMessageBox>
 #include <QEvent>
 #include "dialognew.h"
+#include "dialogresize.h"
+#include "dialoglayout.h"
+#include <random>
 
 void KkrEditMain::setupMainMenu()
 {
@@ -14,9 +21,73 @@ void KkrEditMain::setupMainMenu()
     // File menu
     QMenu *pMenuFile = new QMenu{tr("&File")};
     pMenuFile->addAction(tr("&New..."), this, &KkrEditMain::newWorkBoard);
+    QAction *pActionOpen = pMenuFile->addAction(tr("&Open..."), this, &KkrEditMain::openWorkBoard);
+    pActionOpen->setShortcut(QKeySequence::Open);
+    QAction *pActionSave = pMenuFile->addAction(tr("&Save"), this, &KkrEditMain::saveWorkBoard);
+    pActionSave->setShortcut(QKeySequence::Save);
+    m_boardActions.append(pActionSave);
+    m_boardActions.append(pMenuFile->addAction(tr("Save &As..."), this, &KkrEditMain::saveWorkBoardAs));
+    pMenuFile->addSeparator();
     pMenuFile->addAction(tr("E&xit"), this, &QWidget::close);
     pMainMenu->addMenu(pMenuFile);
 
+    // Edit menu
+    QMenu *pMenuEdit = new QMenu{tr("&Edit")};
+    m_pActionUndo = pMenuEdit->addAction(tr("&Undo"), &m_BoardData, &KkrBoardManager::slUndo);
+    m_pActionUndo->setShortcut(QKeySequence::Undo);
+    m_pActionUndo->setEnabled(false);
+    m_pActionRedo = pMenuEdit->addAction(tr("&Redo"), &m_BoardData, &KkrBoardManager::slRedo);
+    m_pActionRedo->setShortcut(QKeySequence::Redo);
+    m_pActionRedo->setEnabled(false);
+    pMenuEdit->addSeparator();
+    m_boardActions.append(pMenuEdit->addAction(tr("&Derive Clues"), &m_BoardData, &KkrBoardManager::slDeriveClues));
+    m_boardActions.append(pMenuEdit->addAction(tr("&Fill Answers"), this, &KkrEditMain::fillAnswers));
+    QAction *pActionAutoClues = pMenuEdit->addAction(tr("&Auto Clues"));
+    pActionAutoClues->setCheckable(true);
+    connect(pActionAutoClues, &QAction::toggled, [this](bool checked) {m_BoardData.setAutoClues(checked);});
+    pMenuEdit->addSeparator();
+    m_boardActions.append(pMenuEdit->addAction(tr("Resi&ze Board..."), this, &KkrEditMain::resizeWorkBoard));
+    m_boardActions.append(pMenuEdit->addAction(tr("&Generate Layout..."), this, &KkrEditMain::generateLayout));
+    pMainMenu->addMenu(pMenuEdit);
+
+    // Selection menu; the selection is extended with shift + cursor keys
+    QMenu *pMenuSelection = new QMenu{tr("&Selection")};
+    QAction *pActionCopy = pMenuSelection->addAction(tr("&Copy"), m_pWorkBoard, &KkrBoardView::slCopySelection);
+    pActionCopy->setShortcut(QKeySequence::Copy);
+    QAction *pActionPaste = pMenuSelection->addAction(tr("&Paste"), m_pWorkBoard, &KkrBoardView::slPaste);
+    pActionPaste->setShortcut(QKeySequence::Paste);
+    pMenuSelection->addAction(tr("C&lear"), m_pWorkBoard, &KkrBoardView::slClearSelection);
+    pMenuSelection->addSeparator();
+    pMenuSelection->addAction(tr("To Cl&ue Cells"), m_pWorkBoard, &KkrBoardView::slSelectionToClues);
+    pMenuSelection->addAction(tr("To &Answer Cells"), m_pWorkBoard, &KkrBoardView::slSelectionToAnswers);
+    pMenuSelection->addAction(tr("Crop &Board"), this, &KkrEditMain::cropWorkBoard);
+    pMenuSelection->addSeparator();
+    const auto addTransform = [this, pMenuSelection](const QString &text, KkrBoardManager::Transform t) {
+        pMenuSelection->addAction(text, this, [this, t]() {
+            if(!m_pWorkBoard->transformSelection(t))
+                statusBar()->showMessage(tr("Select a square area to rotate"), 3000);
+        });
+    };
+    addTransform(tr("&Mirror Left-Right"), KkrBoardManager::Transform::MirrorLeftRight);
+    addTransform(tr("Mirror &Top-Bottom"), KkrBoardManager::Transform::MirrorTopBottom);
+    addTransform(tr("Rotate &180"), KkrBoardManager::Transform::Rotate180);
+    addTransform(tr("Rotate &Right"), KkrBoardManager::Transform::RotateRight);
+    addTransform(tr("Rotate L&eft"), KkrBoardManager::Transform::RotateLeft);
+    pMenuSelection->addSeparator();
+    pMenuSelection->addAction(tr("Poi&nt Symmetry"), this, [this]() {
+        m_pWorkBoard->applySymmetry(KkrBoardManager::Symmetry::Point);
+    });
+    pMenuSelection->addAction(tr("R&otational Symmetry"), this, [this]() {
+        if(!m_pWorkBoard->applySymmetry(KkrBoardManager::Symmetry::Rotational))
+            statusBar()->showMessage(tr("Rotational symmetry needs a square board"), 3000);
+    });
+    m_boardActions.append(pMenuSelection->actions());
+    pMainMenu->addMenu(pMenuSelection);
+
+    // no board to act on until the first one is created or opened
+    for(QAction *pAction : m_boardActions)
+        pAction->setEnabled(false);
+
     // View menu
     m_pMenuView = new QMenu{tr("&View")};
     pMainMenu->addMenu(m_pMenuView);
@@ -58,17 +129,67 @@ void KkrEditMain::setupDocks()
     addDockWidget(Qt::LeftDockWidgetArea, pDockMetaData);
 }
 
+void KkrEditMain::setupStatusBar()
+{
+    m_pUniqueness = new QLabel;
+    statusBar()->addPermanentWidget(m_pUniqueness);
+}
+
 KkrEditMain::KkrEditMain(QWidget *parent)
     : QMainWindow(parent)
+    , m_Checker(&m_BoardData)
+    , m_modified(false)
+    , m_editCount(0)
+    , m_boardGeneration(0)
+    , m_saving(false)
+    , m_savingEditCount(0)
+    , m_pLayoutDialog(nullptr)
+    , m_layoutGeneration(0)
+    , m_pFillDialog(nullptr)
+    , m_fillGeneration(0)
+    , m_fillCols(0)
+    , m_fillRows(0)
 {
     makeCoreWidgets();
     setupCentralPane();
     setupMainMenu();
     setupDocks();
+    setupStatusBar();
 
     // connections
     connect(this, &KkrEditMain::sigNewMeta, &m_MetaData, &MetaDataManager::slCreate);
     connect(this, &KkrEditMain::sigNewBoard, &m_BoardData, &KkrBoardManager::slCreate);
+    connect(&m_Checker, &UniquenessChecker::sigChecking, this, &KkrEditMain::showChecking);
+    connect(&m_Checker, &UniquenessChecker::sigChecked, this, &KkrEditMain::showUniqueness);
+    connect(&m_BoardData, &KkrBoardManager::sigEdited, this, [this]() {setModified(true);});
+    connect(&m_MetaData, &MetaDataManager::sigEdited, this, [this]() {setModified(true);});
+    connect(&m_BoardData, &KkrBoardManager::sigEdited, this, [this]() {++m_boardGeneration;});
+    connect(&m_BoardData, &KkrBoardManager::sigReset, this, [this]() {
+        ++m_boardGeneration;
+        for(QAction *pAction : m_boardActions)
+            pAction->setEnabled(true);
+    });
+    connect(&m_BoardData, &KkrBoardManager::sigUndoChanged, this, [this]() {
+        m_pActionUndo->setEnabled(m_BoardData.canUndo());
+        m_pActionRedo->setEnabled(m_BoardData.canRedo());
+    });
+    connect(&m_saveWatcher, &QFutureWatcher<bool>::finished, this, &KkrEditMain::saveFinished);
+    connect(&m_openWatcher, &QFutureWatcher<BoardFile>::finished, this, &KkrEditMain::openFinished);
+    connect(&m_fillWatcher, &QFutureWatcher<FillOutcome>::finished, this, &KkrEditMain::fillFinished);
+    connect(&m_layoutWatcher, &QFutureWatcher<std::vector<std::uint8_t>>::finished,
+            this, &KkrEditMain::layoutFinished);
+    m_layoutTimer.setInterval(PROGRESS_MSEC);
+    connect(&m_layoutTimer, &QTimer::timeout, this, [this]() {
+        if(m_pLayoutDialog != nullptr && m_pLayoutProgress)
+            m_pLayoutDialog->setValue(m_pLayoutProgress->load());
+    });
+    m_fillTimer.setInterval(PROGRESS_MSEC);
+    connect(&m_fillTimer, &QTimer::timeout, this, [this]() {
+        if(m_pFillDialog != nullptr && m_pFillProgress)
+            m_pFillDialog->setValue(m_pFillProgress->load());
+    });
+
+    setFileName(QString());
 }
 
 KkrEditMain::~KkrEditMain()
@@ -76,17 +197,125 @@ KkrEditMain::~KkrEditMain()
 
 }
 
+/*
+ * file
+ */
+namespace {
+
+bool saveSnapshot(const QString &fileName, std::shared_ptr<const BoardData> pBoard,
+                  std::shared_ptr<const MetaData> pMeta)
+{
+    return saveBoardFile(fileName, *pBoard, *pMeta);
+}
+
+}   // namespace
+
+bool KkrEditMain::confirmDiscard()
+{
+    // a save in progress decides whether there is anything left to lose
+    waitForSave();
+    if(!m_modified)
+        return true;
+
+    const auto answer = QMessageBox::question(this, tr("Kakuro Editor"), tr("Problem is updated. Save?"),
+                                              QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel);
+    if(answer == QMessageBox::Cancel)
+        return false;
+    if(answer == QMessageBox::Yes) {
+        saveWorkBoard();
+        waitForSave();
+        // still modified if the file dialog was cancelled or the save failed
+        return !m_modified;
+    }
+    return true;
+}
+
+void KkrEditMain::setFileName(const QString &fileName)
+{
+    m_fileName = fileName;
+    const QString name{fileName.isEmpty() ? tr("Untitled") : QFileInfo(fileName).fileName()};
+    setWindowTitle(name + "[*] - " + tr("Kakuro Editor"));
+}
+
+void KkrEditMain::setModified(bool modified)
+{
+    m_modified = modified;
+    if(modified)
+        ++m_editCount;
+    setWindowModified(modified);
+}
+
+void KkrEditMain::startSave(const QString &fileName)
+{
+    if(m_saveWatcher.isRunning()) {
+        statusBar()->showMessage(tr("Still saving; try again shortly"), 3000);
+        return;
+    }
+
+    // the board may be edited while the snapshot is written
+    std::shared_ptr<const BoardData> pBoard{m_BoardData.getBoardData()};
+    std::shared_ptr<const MetaData> pMeta{new MetaData{m_MetaData.getAuthor(),
+            m_MetaData.getBeginnerTime(), m_MetaData.getIntermediateTime(),
+            m_MetaData.getAdvancedTime(), m_MetaData.getExpertTime()}};
+
+    // the name and the modified flag change only once the file is written
+    m_saving = true;
+    m_savingFileName = fileName;
+    m_savingEditCount = m_editCount;
+    statusBar()->showMessage(tr("Saving %1...").arg(QFileInfo(fileName).fileName()));
+    m_saveWatcher.setFuture(QtConcurrent::run(saveSnapshot, fileName, pBoard, pMeta));
+}
+
+void KkrEditMain::saveFinished()
+{
+    // reached from the watcher and from waitForSave, whichever comes first
+    if(!m_saving)
+        return;
+    m_saving = false;
+
+    if(m_saveWatcher.result()) {
+        setFileName(m_savingFileName);
+        // edits made while writing are not in the file
+        if(m_editCount == m_savingEditCount)
+            setModified(false);
+        statusBar()->showMessage(tr("Saved"), 3000);
+    } else {
+        statusBar()->clearMessage();
+        QMessageBox::warning(this, tr("Kakuro Editor"), tr("Cannot save %1").arg(m_savingFileName));
+    }
+}
+
+void KkrEditMain::waitForSave()
+{
+    m_saveWatcher.waitForFinished();
+    saveFinished();
+}
+
+void KkrEditMain::openFinished()
+{
+    statusBar()->clearMessage();
+    const BoardFile file{m_openWatcher.result()};
+    if(file.pBoard == nullptr) {
+        QMessageBox::warning(this, tr("Kakuro Editor"), tr("Cannot open %1").arg(m_openingFileName));
+        return;
+    }
+
+    m_MetaData.slRead(file.pMeta);
+    m_BoardData.slRead(file.pBoard);
+    setFileName(m_openingFileName);
+    // the views write the loaded values back while they reset
+    setModified(false);
+
+    m_pWorkBoard->setFocus();
+}
+
 /*
  * Menu actions
  */
 void KkrEditMain::newWorkBoard()
 {
-    if(m_pWorkBoard->isEdited()) {
-        const auto bSave = QMessageBox::question(this, tr("Kakuro Editor"),
-                                                 tr("Problem is updated. Save?"));
-        if(bSave == QMessageBox::Yes)
-            saveWorkBoard();
-    }
+    if(!confirmDiscard())
+        return;
 
     DialogNew dlgNew{this};
     if(dlgNew.exec() == QDialog::Rejected)
@@ -96,14 +325,297 @@ void KkrEditMain::newWorkBoard()
     // UI size excludes topmost clue-only row and leftmost clue-only column
     // Internal data includes them
     emit sigNewBoard(dlgNew.getNumCols()+1, dlgNew.getNumRows()+1);
+    setFileName(QString());
+    setModified(false);
 
     m_pWorkBoard->setFocus();
 }
 
+void KkrEditMain::openWorkBoard()
+{
+    if(m_openWatcher.isRunning() || !confirmDiscard())
+        return;
+
+    const QString fileName = QFileDialog::getOpenFileName(this, tr("Open Problem"), QString(),
+                                                          tr("Kakuro (*.kkr)"));
+    if(fileName.isEmpty())
+        return;
+
+    m_openingFileName = fileName;
+    statusBar()->showMessage(tr("Opening %1...").arg(QFileInfo(fileName).fileName()));
+    m_openWatcher.setFuture(QtConcurrent::run(loadBoardFile, fileName));
+}
+
 void KkrEditMain::saveWorkBoard()
 {
-    // TODO
-    QMessageBox::information(this, tr("kakuro Editor"), "Not implemented yet");
+    if(m_fileName.isEmpty())
+        saveWorkBoardAs();
+    else
+        startSave(m_fileName);
+}
+
+void KkrEditMain::saveWorkBoardAs()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save Problem"), m_fileName,
+                                                    tr("Kakuro (*.kkr)"));
+    if(fileName.isEmpty())
+        return;
+    if(QFileInfo(fileName).suffix().isEmpty())
+        fileName += ".kkr";
+    startSave(fileName);
+}
+
+void KkrEditMain::resizeWorkBoard()
+{
+    // UI size excludes topmost clue-only row and leftmost clue-only column
+    DialogResize dlgResize{m_BoardData.getNumCols()-1, m_BoardData.getNumRows()-1, this};
+    if(dlgResize.exec() == QDialog::Rejected)
+        return;
+
+    m_BoardData.slResize(dlgResize.getLeft(), dlgResize.getTop(),
+                         dlgResize.getRight(), dlgResize.getBottom());
+    m_pWorkBoard->setFocus();
+}
+
+void KkrEditMain::cropWorkBoard()
+{
+    // the selection in the answer area becomes the whole answer area
+    const QRect sel{m_pWorkBoard->getSelection()
+                    & QRect(1, 1, m_BoardData.getNumCols()-1, m_BoardData.getNumRows()-1)};
+    if(sel.width() < 2 || sel.height() < 2) {
+        statusBar()->showMessage(tr("Select at least 2 X 2 answer area cells to crop to"), 3000);
+        return;
+    }
+    m_BoardData.slResize(1 - sel.left(), 1 - sel.top(),
+                         sel.right() - (m_BoardData.getNumCols()-1),
+                         sel.bottom() - (m_BoardData.getNumRows()-1));
+}
+
+void KkrEditMain::generateLayout()
+{
+    if(m_layoutWatcher.isRunning())
+        return;
+
+    // the answer area, without the topmost row and the leftmost column
+    const int cols = m_BoardData.getNumCols()-1;
+    const int rows = m_BoardData.getNumRows()-1;
+    DialogLayout dlgLayout{cols == rows, this};
+    if(dlgLayout.exec() == QDialog::Rejected)
+        return;
+
+    m_layoutRequest.cols = cols;
+    m_layoutRequest.rows = rows;
+    m_layoutRequest.density = dlgLayout.getDensity();
+    m_layoutRequest.symmetry = dlgLayout.getSymmetry();
+    m_layoutRequest.seed = std::random_device()();
+    m_layoutGeneration = m_boardGeneration;
+    m_pLayoutCancel = std::make_shared<std::atomic_bool>(false);
+    m_pLayoutProgress = std::make_shared<std::atomic_int>(0);
+
+    m_pLayoutDialog = new QProgressDialog{tr("Generating a layout..."), tr("Cancel"), 0, 100, this};
+    m_pLayoutDialog->setWindowModality(Qt::WindowModal);
+    m_pLayoutDialog->setAutoReset(false);
+    m_pLayoutDialog->setMinimumDuration(500);
+    connect(m_pLayoutDialog, &QProgressDialog::canceled, this, &KkrEditMain::cancelLayout);
+
+    m_layoutWatcher.setFuture(QtConcurrent::run(&KkrEditMain::generateCandidates, m_layoutRequest,
+                                                m_pLayoutCancel, m_pLayoutProgress));
+    m_layoutTimer.start();
+}
+
+std::vector<std::uint8_t> KkrEditMain::generateCandidates(LayoutRequest request,
+                                                          std::shared_ptr<std::atomic_bool> pCancel,
+                                                          std::shared_ptr<std::atomic_int> pProgress)
+{
+    LayoutGenerator generator{request.cols, request.rows, request.density, request.symmetry, request.seed};
+    std::vector<std::uint8_t> layout;
+    for(int attempts = 0; attempts < MAX_LAYOUT_ATTEMPTS; ++attempts) {
+        if(pCancel->load())
+            break;
+        pProgress->store(attempts * 100 / MAX_LAYOUT_ATTEMPTS);
+        if(generator.generate(layout))
+            return layout;
+    }
+    return std::vector<std::uint8_t>();
+}
+
+void KkrEditMain::cancelLayout()
+{
+    if(m_pLayoutCancel)
+        m_pLayoutCancel->store(true);
+}
+
+void KkrEditMain::layoutFinished()
+{
+    m_layoutTimer.stop();
+    m_pLayoutDialog->deleteLater();
+    m_pLayoutDialog = nullptr;
+    const bool cancelled = m_pLayoutCancel->load();
+    m_pLayoutCancel.reset();
+    m_pLayoutProgress.reset();
+
+    const std::vector<std::uint8_t> layout{m_layoutWatcher.result()};
+    if(cancelled)
+        return;
+    // the board can still be edited or resized before the dialog shows
+    const int cols = m_layoutRequest.cols;
+    const int rows = m_layoutRequest.rows;
+    if(m_layoutGeneration != m_boardGeneration || cols != m_BoardData.getNumCols()-1
+            || rows != m_BoardData.getNumRows()-1) {
+        statusBar()->showMessage(tr("Board changed while generating; layout not applied"), 3000);
+        return;
+    }
+    if(layout.empty()) {
+        statusBar()->showMessage(tr("No layout found; try a lower density"), 3000);
+        return;
+    }
+
+    // empty cells; the clues next to answer cells are opened as they are written
+    KkrBoardManager::CellBlock block;
+    block.cols = cols;
+    block.rows = rows;
+    block.cells.resize(layout.size());
+    for(std::size_t i = 0; i < layout.size(); ++i) {
+        Cell &cell = block.cells[i];
+        if(layout[i] != 0) {
+            cell.ctype = CellType::CellClue;
+            cell.clueRight = cell.clueDown = EMPTY_CLUE;
+        } else {
+            cell.ctype = CellType::CellAnswer;
+            cell.answer = EMPTY_ANSWER;
+        }
+    }
+    m_BoardData.pasteCells(1, 1, block);
+    m_pWorkBoard->setFocus();
+}
+
+void KkrEditMain::fillAnswers()
+{
+    if(m_fillWatcher.isRunning())
+        return;
+
+    // the board can still be edited before the dialog shows; fillFinished drops such results
+    std::shared_ptr<const BoardData> pBoard{m_BoardData.getBoardData()};
+    m_fillGeneration = m_boardGeneration;
+    m_fillCols = m_BoardData.getNumCols();
+    m_fillRows = m_BoardData.getNumRows();
+    m_pFillCancel = std::make_shared<std::atomic_bool>(false);
+    m_pFillProgress = std::make_shared<std::atomic_int>(0);
+
+    m_pFillDialog = new QProgressDialog{tr("Solving the clues..."), tr("Cancel"), 0, 100, this};
+    m_pFillDialog->setWindowModality(Qt::WindowModal);
+    m_pFillDialog->setAutoReset(false);
+    m_pFillDialog->setMinimumDuration(500);
+    connect(m_pFillDialog, &QProgressDialog::canceled, this, &KkrEditMain::cancelFill);
+
+    m_fillWatcher.setFuture(QtConcurrent::run(&KkrEditMain::solveSnapshot, pBoard,
+                                              m_pFillCancel, m_pFillProgress));
+    m_fillTimer.start();
+}
+
+/*
+ * uniqueness check
+ */
+void KkrEditMain::showChecking()
+{
+    m_pUniqueness->setText(tr("Checking solutions..."));
+    m_pWorkBoard->slSetAmbiguousCells(std::vector<int>());
+}
+
+void KkrEditMain::showUniqueness(KkrSolver::Result result, const std::vector<int> &differingCells)
+{
+    switch(result) {
+    case KkrSolver::Result::Unique:
+        m_pUniqueness->setText(tr("Unique solution"));
+        break;
+    case KkrSolver::Result::Multiple:
+        m_pUniqueness->setText(tr("Multiple solutions: %n cell(s) differ", "", static_cast<int>(differingCells.size())));
+        break;
+    case KkrSolver::Result::NoSolution:
+        m_pUniqueness->setText(tr("No solution"));
+        break;
+    case KkrSolver::Result::Incomplete:
+        m_pUniqueness->setText(tr("Clues missing"));
+        break;
+    case KkrSolver::Result::Cancelled:
+        break;
+    }
+    m_pWorkBoard->slSetAmbiguousCells(differingCells);
+}
+
+/*
+ * answer fill
+ */
+KkrEditMain::FillOutcome KkrEditMain::solveSnapshot(std::shared_ptr<const BoardData> pBoard,
+                                                    std::shared_ptr<std::atomic_bool> pCancel,
+                                                    std::shared_ptr<std::atomic_int> pProgress)
+{
+    KkrSolver solver{*pBoard};
+    FillOutcome outcome;
+    outcome.result = solver.solve(pCancel.get(), pProgress.get());
+    outcome.solution = solver.getSolution();
+    return outcome;
+}
+
+void KkrEditMain::cancelFill()
+{
+    if(m_pFillCancel)
+        m_pFillCancel->store(true);
+}
+
+void KkrEditMain::fillFinished()
+{
+    m_fillTimer.stop();
+    m_pFillDialog->deleteLater();
+    m_pFillDialog = nullptr;
+    m_pFillCancel.reset();
+    m_pFillProgress.reset();
+
+    const FillOutcome outcome{m_fillWatcher.result()};
+    if(m_fillGeneration != m_boardGeneration || m_fillCols != m_BoardData.getNumCols()
+            || m_fillRows != m_BoardData.getNumRows()) {
+        if(outcome.result != KkrSolver::Result::Cancelled)
+            statusBar()->showMessage(tr("Board changed while solving; answers not filled"), 3000);
+        return;
+    }
+    switch(outcome.result) {
+    case KkrSolver::Result::Unique:
+        m_BoardData.slSetAnswers(outcome.solution);
+        break;
+    case KkrSolver::Result::Multiple: {
+        const auto answer = QMessageBox::question(this, tr("Kakuro Editor"),
+                tr("The clues have more than one solution. Fill in one of them?"));
+        if(answer == QMessageBox::Yes)
+            m_BoardData.slSetAnswers(outcome.solution);
+        break;
+    }
+    case KkrSolver::Result::NoSolution:
+        QMessageBox::warning(this, tr("Kakuro Editor"), tr("The clues have no solution."));
+        break;
+    case KkrSolver::Result::Incomplete:
+        QMessageBox::warning(this, tr("Kakuro Editor"), tr("Some runs have no clue yet."));
+        break;
+    case KkrSolver::Result::Cancelled:
+        break;
+    }
+    m_pWorkBoard->setFocus();
+}
+
+/*
+ * events
+ */
+void KkrEditMain::closeEvent(QCloseEvent *e)
+{
+    if(!confirmDiscard()) {
+        e->ignore();
+        return;
+    }
+    // confirmDiscard has waited for any save; a layout or a fill is of no use any more
+    cancelLayout();
+    cancelFill();
+    m_layoutWatcher.waitForFinished();
+    m_fillWatcher.waitForFinished();
+    e->accept();
 }
 
 /*
@@ -3,12 +3,25 @@
 
 #include <QMainWindow>
 #include <QMenu>
+#include <QAction>
+#include <QLabel>
 #include <QScrollArea>
+#include <QFutureWatcher>
+#include <QProgressDialog>
+#include <QTimer>
+#include <QCloseEvent>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 #include "kkrworkboard.h"
 #include "metadatamanager.h"
 #include "metadataview.h"
 #include "kkrboardmanager.h"
 #include "kkrworkboard.h"
+#include "uniquenesschecker.h"
+#include "boardfile.h"
+#include "layoutgenerator.h"
 
 class KkrEditMain : public QMainWindow
 {
@@ -23,12 +36,19 @@ class KkrEditMain : public QMainWindow
 
     // Menu
     QMenu *m_pMenuView;
+    QAction *m_pActionUndo;
+    QAction *m_pActionRedo;
+    QList<QAction *> m_boardActions;    // enabled once there is a board
+
+    // status bar
+    QLabel *m_pUniqueness;
 
     /*
      * models
      */
     KkrBoardManager m_BoardData;
     MetaDataManager m_MetaData;
+    UniquenessChecker m_Checker;
 
     /*
      * initialization
@@ -37,6 +57,92 @@ class KkrEditMain : public QMainWindow
     void makeCoreWidgets();
     void setupCentralPane();
     void setupDocks();
+    void setupStatusBar();
+
+    /*
+     * file
+     * saved from a snapshot and read on the global thread pool
+     */
+    QString m_fileName;         // empty until saved or opened
+    bool m_modified;
+    unsigned m_editCount;       // bumped on every edit
+    unsigned m_boardGeneration; // bumped on every board edit or reset
+    QFutureWatcher<bool> m_saveWatcher;
+    bool m_saving;              // until the save result is handled
+    QString m_savingFileName;
+    unsigned m_savingEditCount; // edit count of the snapshot being saved
+    QFutureWatcher<BoardFile> m_openWatcher;
+    QString m_openingFileName;
+
+    bool confirmDiscard();
+        // false if the user cancelled or the save failed
+    void setFileName(const QString &fileName);
+    void setModified(bool modified);
+    void startSave(const QString &fileName);
+    void saveFinished();
+    void waitForSave();
+        // blocks until a save in progress is written and handled
+    void openFinished();
+
+    static const int PROGRESS_MSEC = 100;
+        // progress dialogs poll the background work this often
+
+    /*
+     * layout generator
+     * candidates are generated on the global thread pool
+     */
+    static const int MAX_LAYOUT_ATTEMPTS = 1000;
+        // candidates tried before giving up
+    struct LayoutRequest {
+        int cols;
+        int rows;
+        int density;
+        LayoutGenerator::Symmetry symmetry;
+        unsigned seed;
+    };
+    QFutureWatcher<std::vector<std::uint8_t>> m_layoutWatcher;
+    std::shared_ptr<std::atomic_bool> m_pLayoutCancel;
+    std::shared_ptr<std::atomic_int> m_pLayoutProgress;
+    QProgressDialog *m_pLayoutDialog;
+    QTimer m_layoutTimer;
+    LayoutRequest m_layoutRequest;
+    unsigned m_layoutGeneration;    // board generation when the layout was requested
+
+    static std::vector<std::uint8_t> generateCandidates(LayoutRequest request,
+                                                        std::shared_ptr<std::atomic_bool> pCancel,
+                                                        std::shared_ptr<std::atomic_int> pProgress);
+        // empty if every candidate was rejected or the user cancelled
+    void cancelLayout();
+    void layoutFinished();
+
+    /*
+     * uniqueness check
+     */
+    void showChecking();
+    void showUniqueness(KkrSolver::Result result, const std::vector<int> &differingCells);
+
+    /*
+     * answer fill
+     * the clues of a snapshot are solved on the global thread pool
+     */
+    struct FillOutcome {
+        KkrSolver::Result result;
+        std::vector<int> solution;      // col + row * numCols
+    };
+    QFutureWatcher<FillOutcome> m_fillWatcher;
+    std::shared_ptr<std::atomic_bool> m_pFillCancel;
+    std::shared_ptr<std::atomic_int> m_pFillProgress;
+    QProgressDialog *m_pFillDialog;
+    QTimer m_fillTimer;
+    unsigned m_fillGeneration;      // board generation of the snapshot being solved
+    int m_fillCols;
+    int m_fillRows;
+
+    static FillOutcome solveSnapshot(std::shared_ptr<const BoardData> pBoard,
+                                     std::shared_ptr<std::atomic_bool> pCancel,
+                                     std::shared_ptr<std::atomic_int> pProgress);
+    void cancelFill();
+    void fillFinished();
 
 public:
     KkrEditMain(QWidget *parent = 0);
@@ -46,13 +152,23 @@ public:
      * Menu actions
      */
     void newWorkBoard();
+    void openWorkBoard();
     void saveWorkBoard();
+    void saveWorkBoardAs();
+    void resizeWorkBoard();
+    void cropWorkBoard();
+        // to the selection
+    void generateLayout();
+    void fillAnswers();
 
     /*
      * event filter
      */
     bool eventFilter(QObject *pWatched, QEvent *e) override;
 
+protected:
+    void closeEvent(QCloseEvent *e) override;
+
 signals:
     void sigNewMeta();
     void sigNewBoard(int cols, int rows);
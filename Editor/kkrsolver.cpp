@@ -0,0 +1,279 @@
+#include "kkrsolver.h"
+#include <utility>
+
+namespace {
+
+int digitBit(int digit) {return 1 << (digit-1);}
+
+int bitCount(int bits)
+{
+    int n = 0;
+    for(; bits != 0; bits &= bits - 1)
+        ++n;
+    return n;
+}
+
+/*
+ * every set of distinct digits by its size and sum, as bits
+ */
+class ComboTable
+{
+    std::vector<int> m_combos[10][46];
+
+public:
+    ComboTable()
+    {
+        for(int bits = 1; bits < 512; ++bits) {
+            int n = 0;
+            int sum = 0;
+            for(int d = 1; d <= 9; ++d) {
+                if(bits & digitBit(d)) {
+                    ++n;
+                    sum += d;
+                }
+            }
+            m_combos[n][sum].push_back(bits);
+        }
+    }
+
+    const std::vector<int> &get(int n, int sum) const {return m_combos[n][sum];}
+};
+
+const ComboTable &comboTable()
+{
+    static const ComboTable table;
+    return table;
+}
+
+// polling the cancel flag on every node costs more than the check itself
+const int CANCEL_POLL_NODES = 4096;
+
+}   // namespace
+
+KkrSolver::KkrSolver(const BoardData &data)
+    : m_numCells(data.getNumCols() * data.getNumRows())
+    , m_broken(false)
+    , m_incomplete(false)
+    , m_pCancel(nullptr)
+    , m_pProgress(nullptr)
+    , m_cancelled(false)
+    , m_numNodes(0)
+    , m_maxDepth(0)
+    , m_numSolutions(0)
+{
+    const int numCols = data.getNumCols();
+    const int numRows = data.getNumRows();
+
+    std::vector<int> cellIds(m_numCells, -1);
+    for(int r = 0; r < numRows; ++r) {
+        for(int c = 0; c < numCols; ++c) {
+            if(data.getCellType(c, r) != CellType::CellAnswer)
+                continue;
+            // the topmost row and the leftmost column head the runs
+            if(c == 0 || r == 0)
+                m_broken = true;
+            SolverCell cell;
+            cell.index = c + r * numCols;
+            cell.run[0] = cell.run[1] = -1;
+            cell.value = 0;
+            cellIds[cell.index] = static_cast<int>(m_cells.size());
+            m_cells.push_back(cell);
+        }
+    }
+
+    for(int r = 0; r < numRows; ++r) {
+        for(int c = 0; c < numCols; ++c) {
+            if(data.getCellType(c, r) != CellType::CellClue)
+                continue;
+            for(int dir = 0; dir < 2; ++dir) {
+                const int dc = dir == 0 ? 1 : 0;
+                const int dr = dir == 0 ? 0 : 1;
+                int length = 0;
+                for(int x = c+dc, y = r+dr; x < numCols && y < numRows
+                        && data.getCellType(x, y) == CellType::CellAnswer; x += dc, y += dr) {
+                    m_cells[cellIds[x + y * numCols]].run[dir] = static_cast<int>(m_runs.size());
+                    ++length;
+                }
+                if(length == 0)
+                    continue;
+
+                Run run;
+                run.clue = dir == 0 ? data.getClueRight(c, r) : data.getClueDown(c, r);
+                run.sum = 0;
+                run.used = 0;
+                run.remaining = length;
+                if(run.clue < 1 || run.clue > 45)
+                    m_incomplete = true;
+                if(length > 9)
+                    m_broken = true;
+                m_runs.push_back(run);
+            }
+        }
+    }
+
+    m_order.resize(m_cells.size());
+    for(std::size_t i = 0; i < m_order.size(); ++i)
+        m_order[i] = static_cast<int>(i);
+    m_pending.reserve(m_cells.size());
+}
+
+KkrSolver::Result KkrSolver::solve(const std::atomic_bool *pCancel, std::atomic_int *pProgress)
+{
+    if(m_broken)
+        return Result::NoSolution;
+    if(m_incomplete)
+        return Result::Incomplete;
+
+    m_pCancel = pCancel;
+    m_pProgress = pProgress;
+    m_cancelled = false;
+    m_numNodes = 0;
+    m_maxDepth = 0;
+    m_numSolutions = 0;
+    m_solution.clear();
+    m_differingCells.clear();
+
+    search();
+    reportProgress();
+
+    if(m_cancelled)
+        return Result::Cancelled;
+    switch(m_numSolutions) {
+    case 0:
+        return Result::NoSolution;
+    case 1:
+        return Result::Unique;
+    default:
+        return Result::Multiple;
+    }
+}
+
+int KkrSolver::allowedDigits(const Run &run) const
+{
+    const int rest = run.clue - run.sum;
+    if(run.remaining == 0 || rest < 0)
+        return 0;
+
+    int bits = 0;
+    for(int combo : comboTable().get(run.remaining, rest))
+        if((combo & run.used) == 0)
+            bits |= combo;
+    return bits;
+}
+
+void KkrSolver::assign(SolverCell &cell, int value)
+{
+    cell.value = value;
+    for(int dir = 0; dir < 2; ++dir) {
+        Run &run = m_runs[cell.run[dir]];
+        run.sum += value;
+        run.used |= digitBit(value);
+        --run.remaining;
+    }
+}
+
+void KkrSolver::unassign(SolverCell &cell)
+{
+    for(int dir = 0; dir < 2; ++dir) {
+        Run &run = m_runs[cell.run[dir]];
+        run.sum -= cell.value;
+        run.used &= ~digitBit(cell.value);
+        ++run.remaining;
+    }
+    cell.value = 0;
+}
+
+void KkrSolver::foundSolution()
+{
+    ++m_numSolutions;
+    if(m_numSolutions == 1) {
+        m_solution.assign(m_numCells, 0);
+        for(const auto &cell : m_cells)
+            m_solution[cell.index] = cell.value;
+    } else {
+        for(const auto &cell : m_cells)
+            if(m_solution[cell.index] != cell.value)
+                m_differingCells.push_back(cell.index);
+    }
+}
+
+void KkrSolver::reportProgress()
+{
+    if(m_pProgress == nullptr)
+        return;
+    const int numCells = static_cast<int>(m_cells.size());
+    m_pProgress->store(numCells == 0 ? 100 : m_maxDepth * 100 / numCells);
+}
+
+bool KkrSolver::enter(int depth)
+{
+    if(depth > m_maxDepth)
+        m_maxDepth = depth;
+    if(m_numNodes++ % CANCEL_POLL_NODES == 0) {
+        reportProgress();
+        if(m_pCancel != nullptr && m_pCancel->load()) {
+            m_cancelled = true;
+            return true;
+        }
+    }
+
+    if(depth == static_cast<int>(m_order.size())) {
+        foundSolution();
+        return m_numSolutions >= 2;
+    }
+
+    // the cell with the fewest candidates next
+    int bestPos = -1;
+    int bestDigits = 0;
+    int bestCount = 10;
+    for(int pos = depth; pos < static_cast<int>(m_order.size()); ++pos) {
+        const SolverCell &cell = m_cells[m_order[pos]];
+        const int digits = allowedDigits(m_runs[cell.run[0]]) & allowedDigits(m_runs[cell.run[1]]);
+        const int count = bitCount(digits);
+        if(count == 0)
+            return false;
+        if(count < bestCount) {
+            bestPos = pos;
+            bestDigits = digits;
+            bestCount = count;
+            if(count == 1)
+                break;
+        }
+    }
+    std::swap(m_order[depth], m_order[bestPos]);
+    m_pending.push_back(bestDigits);
+    return false;
+}
+
+void KkrSolver::search()
+{
+    m_pending.clear();
+    int depth = 0;
+    while(!enter(depth)) {
+        // the next untried digit, backtracking from the exhausted cells
+        while(!m_pending.empty()) {
+            SolverCell &cell = m_cells[m_order[m_pending.size()-1]];
+            if(cell.value != 0)
+                unassign(cell);
+            int &digits = m_pending.back();
+            if(digits == 0) {
+                m_pending.pop_back();
+                continue;
+            }
+            const int bit = digits & -digits;
+            digits &= ~bit;
+            assign(cell, bitCount(bit-1) + 1);
+            break;
+        }
+        if(m_pending.empty())
+            return;
+        depth = static_cast<int>(m_pending.size());
+    }
+
+    // stopped early; leave the runs as they were
+    for(std::size_t pos = 0; pos < m_pending.size(); ++pos) {
+        SolverCell &cell = m_cells[m_order[pos]];
+        if(cell.value != 0)
+            unassign(cell);
+    }
+}
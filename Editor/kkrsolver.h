@@ -0,0 +1,80 @@
+#ifndef KKRSOLVER_H
+#define KKRSOLVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "boarddata.h"
+
+/*
+ * Solution counter for the editor
+ * Searches the board for solutions of its clues; the answers entered by the
+ * author are ignored. The search stops at the second solution, so it tells
+ * a unique problem from an ambiguous one without enumerating them all.
+ */
+class KkrSolver
+{
+public:
+    enum class Result {
+        Unique, Multiple, NoSolution, Incomplete, Cancelled
+    };
+        // Incomplete: a run has no clue yet
+
+    explicit KkrSolver(const BoardData &data);
+
+    KkrSolver(const KkrSolver &) = delete;
+    KkrSolver &operator=(const KkrSolver &) = delete;
+
+    Result solve(const std::atomic_bool *pCancel = nullptr, std::atomic_int *pProgress = nullptr);
+        // pCancel is polled during the search; may be set from another thread
+        // pProgress gets the percentage of cells in the deepest partial solution so far
+
+    const std::vector<int> &getSolution() const {return m_solution;}
+        // the first solution found, per cell (col + row * numCols); 0 for clue cells
+    const std::vector<int> &getDifferingCells() const {return m_differingCells;}
+        // Multiple: cells (col + row * numCols) where the two solutions found differ
+
+private:
+    struct Run {
+        int clue;
+        int sum;
+        int used;           // digits in the run as bits
+        int remaining;      // # of cells without a digit
+    };
+    struct SolverCell {
+        int index;          // col + row * numCols
+        int run[2];         // right and down
+        int value;
+    };
+
+    int m_numCells;
+    bool m_broken;          // answer cells outside runs or runs too long
+    bool m_incomplete;
+    std::vector<Run> m_runs;
+    std::vector<SolverCell> m_cells;
+    std::vector<int> m_order;
+        // cell ids; the first depth are assigned
+    std::vector<int> m_pending;
+        // search stack: digits still to try for the cell at m_order[depth]
+
+    const std::atomic_bool *m_pCancel;
+    std::atomic_int *m_pProgress;
+    bool m_cancelled;
+    std::uint64_t m_numNodes;
+    int m_maxDepth;
+    int m_numSolutions;
+    std::vector<int> m_solution;
+    std::vector<int> m_differingCells;
+
+    int allowedDigits(const Run &run) const;
+    void assign(SolverCell &cell, int value);
+    void unassign(SolverCell &cell);
+    void foundSolution();
+    void reportProgress();
+    bool enter(int depth);
+        // visits a node; true when the search is over: two solutions or cancelled
+    void search();
+        // depth first with an explicit stack, so deep boards cannot overflow the thread's stack
+};
+
+#endif // KKRSOLVER_H
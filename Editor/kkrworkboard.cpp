@@ -1,126 +1,70 @@
 #include "kkrworkboard.h"
 #include <QPainter>
 #include <QKeyEvent>
-#include <array>
-
-// dimensions
-static const int MARGIN = 10;
-static const int FRAME_THICK = 5;
-static const int BORDER_THICK = 1;
-static const int CELL_WIDTH = 36;
-static const int CLUE_WIDTH = CELL_WIDTH/2 - 4;
-
-// font face
-static const char FONT_ANS[] = "consolas";
-static const char FONT_CLUE[] = "consolas";
+#include <QPaintEvent>
+#include <algorithm>
 
 KkrBoardView::KkrBoardView(KkrBoardManager *pBoardData, QWidget *parent)
     : QWidget(parent)
-    , m_fontAns(FONT_ANS)
-    , m_fontClue(FONT_CLUE)
+    , m_board_width(0)
+    , m_board_height(0)
+    , m_curCol(0)
+    , m_curRow(0)
+    , m_curClue(CursorClue::None)
+    , m_anchorCol(0)
+    , m_anchorRow(0)
     , m_pBoardData(pBoardData)
+    , m_pScrollArea(nullptr)
 {
-    m_fontAns.setPixelSize(CELL_WIDTH);
-    m_fontClue.setPixelSize(CLUE_WIDTH);
     setMinimumHeight(300);
     setMinimumWidth(400);
 
     connect(pBoardData, &KkrBoardManager::sigReset, this, &KkrBoardView::slReset);
-}
-
-QRect KkrBoardView::getCellRect(int col, int row) const
-{
-    const int x = MARGIN + FRAME_THICK + col * (CELL_WIDTH + BORDER_THICK);
-    const int y = MARGIN + FRAME_THICK + row * (CELL_WIDTH + BORDER_THICK);
-    return QRect(x, y, CELL_WIDTH, CELL_WIDTH);
-}
-
-QRect KkrBoardView::getClueRectRight(const QRect &cellRect) const
-{
-    const QPoint topRight{cellRect.topRight()};
-    const int x = topRight.x() - CLUE_WIDTH - 1;
-    const int y = topRight.y() + 2;
-    return QRect(x, y, CLUE_WIDTH, CLUE_WIDTH);
-}
-
-QRect KkrBoardView::getClueRectDown(const QRect &cellRect) const
-{
-    const QPoint bottomLeft{cellRect.bottomLeft()};
-    const int x = bottomLeft.x() + 2;
-    const int y = bottomLeft.y() - CLUE_WIDTH - 1;
-    return QRect(x, y, CLUE_WIDTH, CLUE_WIDTH);
+    // the edited cells and those whose validity marks changed; validity never changes without an edit
+    connect(pBoardData, &KkrBoardManager::sigEdited, this, &KkrBoardView::updateCells);
 }
 
 void KkrBoardView::drawCell(QPainter &p, int col, int row) const
 {
-    static const char * digits[] = {
-        " ",  "1",  "2",  "3",  "4",  "5",  "6",  "7",  "8",  "9",
-        "10", "11", "12", "13", "14", "15", "16", "17", "18", "19",
-        "20", "21", "22", "23", "24", "25", "26", "27", "28", "29",
-        "30", "31", "32", "33", "34", "35", "36", "37", "38", "39",
-        "40", "41", "42", "43", "44", "45"
-    };
-    const QRect cellRect{getCellRect(col, row)};
+    const bool onCursor = m_curCol == col && m_curRow == row;
     switch(m_pBoardData->getCellType(col, row)) {
     case CellType::CellAnswer:
     {
-        if(m_curCol == col && m_curRow == row) {
-            QBrush brCyan(Qt::cyan);
-            p.fillRect(cellRect, brCyan);
-        }
+        if(onCursor)
+            p.fillRect(getCellRect(col, row), m_painter.getBrush(BoardPainter::Fill::Cursor));
+        else if(m_pBoardData->isCellInvalid(col, row))
+            p.fillRect(getCellRect(col, row), m_painter.getBrush(BoardPainter::Fill::Mistake));
+        else if(m_ambiguous[col + row * m_pBoardData->getNumCols()])
+            p.fillRect(getCellRect(col, row), m_painter.getBrush(BoardPainter::Fill::Ambiguous));
         const int ans = m_pBoardData->getAnswer(col, row);
-        if(ans != EMPTY_ANSWER) {
-            p.setFont(m_fontAns);
-            p.drawText(cellRect, Qt::AlignCenter | Qt::AlignHCenter, digits[ans]);
-        }
+        if(ans != EMPTY_ANSWER)
+            m_painter.drawAnswer(p, col, row, ans);
     }
         break;
     case CellType::CellClue:
     {
-        const bool onCursor = m_curCol==col && m_curRow==row;
-        QBrush brWhite(Qt::white);
-        QBrush brBlack(Qt::black);
-        QBrush brCyan(Qt::cyan);
-
-        if(onCursor && m_curClue==CursorClue::None)
-            p.setBrush(brCyan);
-        else
-            p.setBrush(brBlack);
-        std::array<QPoint, 3> points;
-
-        // upper right triangle
-        points[0] = cellRect.topLeft(); points[0] += QPoint(2,1);
-        points[1] = cellRect.topRight(); points[1] += QPoint(-1,1);
-        points[2] = cellRect.bottomRight(); points[2] += QPoint(-1,-2);
-        p.drawPolygon(points.data(), static_cast<int>(points.size()));
-
-        // bottom left triangle
-        points[0] = cellRect.topLeft(); points[0] += QPoint(1,2);
-        points[1] = cellRect.bottomLeft(); points[1] += QPoint(1,-1);
-        points[2] = cellRect.bottomRight(); points[2] += QPoint(-2,-1);
-        p.drawPolygon(points.data(), static_cast<int>(points.size()));
-
-        if(m_pBoardData->getClueRight(col, row) != CLOSED_CLUE) {
-            const QRect clueRect{getClueRectRight(cellRect)};
-            if(onCursor && m_curClue==CursorClue::Right)
-                p.fillRect(clueRect, brCyan);
-            else
-                p.fillRect(clueRect, brWhite);
-            p.setFont(m_fontClue);
-            p.drawText(clueRect, Qt::AlignCenter | Qt::AlignHCenter,
-                        digits[m_pBoardData->getClueRight(col, row)]);
-        }
-
-        if(m_pBoardData->getClueDown(col, row) != CLOSED_CLUE) {
-            const QRect clueRect{getClueRectDown(cellRect)};
-            if(onCursor && m_curClue==CursorClue::Down)
-                p.fillRect(clueRect, brCyan);
-            else
-                p.fillRect(clueRect, brWhite);
-            p.setFont(m_fontClue);
-            p.drawText(clueRect, Qt::AlignCenter | Qt::AlignHCenter,
-                       digits[m_pBoardData->getClueDown(col, row)]);
+        BoardPainter::ClueHighlight highlight = BoardPainter::ClueHighlight::None;
+        if(onCursor) {
+            switch(m_curClue) {
+            case CursorClue::None:
+                highlight = BoardPainter::ClueHighlight::Cell;
+                break;
+            case CursorClue::Right:
+                highlight = BoardPainter::ClueHighlight::Right;
+                break;
+            case CursorClue::Down:
+                highlight = BoardPainter::ClueHighlight::Down;
+                break;
+            }
         }
+        int marks = BoardPainter::MarkNone;
+        if(m_pBoardData->isRunInvalid(col, row, KkrBoardManager::RunDir::Right))
+            marks |= BoardPainter::MarkRight;
+        if(m_pBoardData->isRunInvalid(col, row, KkrBoardManager::RunDir::Down))
+            marks |= BoardPainter::MarkDown;
+        // same closed/empty values as the painter: CLOSED_CLUE is -1, EMPTY_CLUE draws no digit
+        m_painter.drawClueCell(p, col, row, m_pBoardData->getClueRight(col, row),
+                               m_pBoardData->getClueDown(col, row), true, highlight, marks);
     }
         break;
     default:
@@ -146,9 +90,45 @@ void KkrBoardView::resetCursor(int col, int row, CursorClue cl)
     // make sure the cursor comes in the visible area
     showCell(col, row);
 
+    // the old cursor and selection, then the new cursor
+    updateCells(getSelection());
     m_curCol = col; m_curRow = row;
     m_curClue = cl;
-    update(); // can be optimized
+    m_anchorCol = col; m_anchorRow = row;
+    updateCursorCell();
+}
+
+void KkrBoardView::extendSelection(int col, int row)
+{
+    Q_ASSERT(col >= 0 && col < m_pBoardData->getNumCols());
+    Q_ASSERT(row >= 0 && row < m_pBoardData->getNumRows());
+
+    showCell(col, row);
+
+    updateCells(getSelection());
+    m_curCol = col; m_curRow = row;
+    m_curClue = CursorClue::None;
+    updateCells(getSelection());
+}
+
+QRect KkrBoardView::getSelection() const
+{
+    return QRect(QPoint(std::min(m_anchorCol, m_curCol), std::min(m_anchorRow, m_curRow)),
+                 QPoint(std::max(m_anchorCol, m_curCol), std::max(m_anchorRow, m_curRow)));
+}
+
+bool KkrBoardView::transformSelection(KkrBoardManager::Transform t)
+{
+    m_curClue = CursorClue::None;
+    updateCursorCell();
+    return m_pBoardData->transformCells(getSelection(), t);
+}
+
+bool KkrBoardView::applySymmetry(KkrBoardManager::Symmetry s)
+{
+    m_curClue = CursorClue::None;
+    updateCursorCell();
+    return m_pBoardData->applySymmetry(getSelection(), s);
 }
 
 /*
@@ -161,6 +141,27 @@ void KkrBoardView::keyCursor(QKeyEvent *e)
     const auto mod = e->modifiers();
     CursorClue cl = m_curClue;
 
+    if(mod == Qt::ShiftModifier) {
+        // whole cells only
+        switch(e->key()) {
+        case Qt::Key_Up:    case Qt::Key_K:
+            newRow = std::max(m_curRow-1, 0);
+            break;
+        case Qt::Key_Down:  case Qt::Key_J:
+            newRow = std::min(m_curRow+1, m_pBoardData->getNumRows()-1);
+            break;
+        case Qt::Key_Left:  case Qt::Key_H:
+            newCol = std::max(m_curCol-1, 0);
+            break;
+        case Qt::Key_Right: case Qt::Key_L:
+            newCol = std::min(m_curCol+1, m_pBoardData->getNumCols()-1);
+            break;
+        }
+        if(m_curCol != newCol || m_curRow != newRow)
+            extendSelection(newCol, newRow);
+        return;
+    }
+
     if(mod == Qt::NoModifier) {
         switch(e->key()) {
         case Qt::Key_Up:    case Qt::Key_K:
@@ -257,7 +258,7 @@ void KkrBoardView::keyCursor(QKeyEvent *e)
         }
     }
 
-    if(m_curCol != newCol || m_curRow != newRow || m_curClue != cl)
+    if(m_curCol != newCol || m_curRow != newRow || m_curClue != cl || hasSelection())
         resetCursor(newCol, newRow, cl);
 }
 
@@ -285,6 +286,9 @@ void KkrBoardView::switchCellType(int col, int row)
     if(col == 0 || row == 0)
         return;
 
+    // the clue fix-ups around the cell are undone with it
+    const KkrBoardManager::EditGroup group{m_pBoardData};
+
     if(m_pBoardData->getCellType(col, row) == CellType::CellClue) {
         m_pBoardData->setCellType(col, row, CellType::CellAnswer);
         m_pBoardData->setAnswer(col, row, EMPTY_ANSWER);
@@ -304,7 +308,8 @@ void KkrBoardView::switchCellType(int col, int row)
     resetClueCell(col-1, row);
     resetClueCell(col, row-1);
 
-    update();
+    // the cursor clue may change without an edit of the cell
+    updateCursorCell();
 }
 
 void KkrBoardView::keyValue(QKeyEvent *e)
@@ -313,6 +318,8 @@ void KkrBoardView::keyValue(QKeyEvent *e)
     if(ct == CellType::CellClue && m_curClue == CursorClue::None)
         return;
 
+    const KkrBoardManager::EditGroup group{m_pBoardData};
+
     int newValue;
     switch(e->key()) {
     case Qt::Key_Delete:
@@ -369,44 +376,39 @@ void KkrBoardView::keyValue(QKeyEvent *e)
     }
         break;
     }
-
-    update();
+    // the edit repaints the changed cells
 }
 
 /*
  * widget events
  */
-void KkrBoardView::paintEvent(QPaintEvent * /*e*/)
+void KkrBoardView::paintEvent(QPaintEvent *e)
 {
     QPainter p{this};
 
-    const auto C = m_pBoardData->getNumCols();
+    const int C = m_pBoardData->getNumCols();
+    const int R = m_pBoardData->getNumRows();
     if(C < 3)
         return;
 
-    // frame
-    p.fillRect(MARGIN, MARGIN, m_frame_width, FRAME_THICK, Qt::SolidPattern);
-    p.fillRect(MARGIN, MARGIN+m_frame_height-FRAME_THICK, m_frame_width, FRAME_THICK, Qt::SolidPattern);
-    p.fillRect(MARGIN, MARGIN, FRAME_THICK, m_frame_height, Qt::SolidPattern);
-    p.fillRect(MARGIN+m_frame_width-FRAME_THICK, MARGIN, FRAME_THICK, m_frame_height, Qt::SolidPattern);
-
-    // cell borders
-    const int TL = MARGIN + FRAME_THICK;
-    for(int yi = 1; yi < m_pBoardData->getNumRows(); ++yi) {
-        const int y = TL - BORDER_THICK + yi * (BORDER_THICK+CELL_WIDTH);
-        p.fillRect(TL, y, m_inner_width, BORDER_THICK, Qt::SolidPattern);
-    }
-
-    for(int xi = 1; xi < m_pBoardData->getNumCols(); ++xi) {
-        const int x = TL - BORDER_THICK + xi * (BORDER_THICK+CELL_WIDTH);
-        p.fillRect(x, TL, BORDER_THICK, m_inner_height, Qt::SolidPattern);
-    }
+    // only the cells in the exposed area, usually the visible part of the scroll area
+    const QRect area{e->rect()};
+    m_painter.paintFrame(p, C, R, area);
+    m_painter.paintBorders(p, C, R, area);
 
-    for(int c = 0; c < m_pBoardData->getNumCols(); ++c) {
-        for(int r = 0; r < m_pBoardData->getNumRows(); ++r) {
+    const QRect range{BoardPainter::getCellRange(C, R, area)};
+    if(range.isEmpty())
+        return;
+    for(int c = range.left(); c <= range.right(); ++c) {
+        for(int r = range.top(); r <= range.bottom(); ++r) {
             drawCell(p, c, r);
         }
     }
+
+    // over the cells, so clue cells show it too
+    if(hasSelection())
+        p.fillRect(BoardPainter::getBlockRect(getSelection()) & area,
+                   m_painter.getBrush(BoardPainter::Fill::Selection));
 }
 
 void KkrBoardView::keyReleaseEvent(QKeyEvent *e)
@@ -429,10 +431,16 @@ void KkrBoardView::keyReleaseEvent(QKeyEvent *e)
     case Qt::Key_4: case Qt::Key_5:
     case Qt::Key_6: case Qt::Key_7:
     case Qt::Key_8: case Qt::Key_9:
-    case Qt::Key_Delete:
         keyValue(e);
         break;
 
+    case Qt::Key_Delete:
+        if(hasSelection())
+            slClearSelection();
+        else
+            keyValue(e);
+        break;
+
     default:
         // just ignore other keys
         break;
@@ -445,18 +453,70 @@ void KkrBoardView::keyReleaseEvent(QKeyEvent *e)
 void KkrBoardView::slReset()
 {
     // sizes
-    m_inner_width = (CELL_WIDTH + BORDER_THICK) * m_pBoardData->getNumCols() - BORDER_THICK;
-    m_inner_height = (CELL_WIDTH + BORDER_THICK) * m_pBoardData->getNumRows() - BORDER_THICK;
-    m_frame_width = 2*FRAME_THICK + m_inner_width;
-    m_frame_height = 2*FRAME_THICK + m_inner_height;
-    m_board_width = 2*MARGIN + m_frame_width;
-    m_board_height = 2*MARGIN + m_frame_height;
+    const QSize boardSize{BoardPainter::getBoardSize(m_pBoardData->getNumCols(), m_pBoardData->getNumRows())};
+    m_board_width = boardSize.width();
+    m_board_height = boardSize.height();
 
     // initial cursor position
     m_curCol = m_curRow = 0;
     m_curClue = CursorClue::None;
+    m_anchorCol = m_anchorRow = 0;
+
+    m_ambiguous.assign(m_pBoardData->getNumCols() * m_pBoardData->getNumRows(), false);
 
     setFixedSize(m_board_width, m_board_height);
 
     update();
 }
+
+void KkrBoardView::slSetAmbiguousCells(const std::vector<int> &cells)
+{
+    // the bounds of the cells marked before and after
+    const int numCols = m_pBoardData->getNumCols();
+    QRect changed;
+    for(std::size_t i = 0; i < m_ambiguous.size(); ++i) {
+        if(m_ambiguous[i]) {
+            changed |= QRect(static_cast<int>(i) % numCols, static_cast<int>(i) / numCols, 1, 1);
+            m_ambiguous[i] = false;
+        }
+    }
+    for(int i : cells) {
+        changed |= QRect(i % numCols, i / numCols, 1, 1);
+        m_ambiguous[i] = true;
+    }
+    updateCells(changed);
+}
+
+void KkrBoardView::slSelectionToClues()
+{
+    m_curClue = CursorClue::None;
+    updateCursorCell();
+    m_pBoardData->fillCellType(getSelection(), CellType::CellClue);
+}
+
+void KkrBoardView::slSelectionToAnswers()
+{
+    m_curClue = CursorClue::None;
+    updateCursorCell();
+    m_pBoardData->fillCellType(getSelection(), CellType::CellAnswer);
+}
+
+void KkrBoardView::slClearSelection()
+{
+    m_pBoardData->clearCells(getSelection());
+}
+
+void KkrBoardView::slCopySelection()
+{
+    m_clipboard = m_pBoardData->copyCells(getSelection());
+}
+
+void KkrBoardView::slPaste()
+{
+    if(m_clipboard.cells.empty())
+        return;
+    m_curClue = CursorClue::None;
+    updateCursorCell();
+    const QRect sel{getSelection()};
+    m_pBoardData->pasteCells(sel.left(), sel.top(), m_clipboard);
+}
@@ -3,22 +3,18 @@
 
 #include <QWidget>
 #include <QScrollArea>
-#include <QFont>
 #include <QPainter>
+#include <vector>
 #include "kkrboardmanager.h"
+#include "boardpainter.h"
 
 class KkrBoardView : public QWidget
 {
     Q_OBJECT
-    // fonts for digits
-    QFont m_fontAns;
-    QFont m_fontClue;
+    // shared with the player
+    BoardPainter m_painter;
 
     // dimensions
-    int m_inner_width;
-    int m_inner_height;
-    int m_frame_width;
-    int m_frame_height;
     int m_board_width;
     int m_board_height;
 
@@ -29,9 +25,17 @@ class KkrBoardView : public QWidget
         None, Down, Right,
     } m_curClue;
 
+    // selection: the cells between the anchor and the cursor
+    int m_anchorCol;
+    int m_anchorRow;
+    KkrBoardManager::CellBlock m_clipboard;
+
     // data
     KkrBoardManager *m_pBoardData;
 
+    // cells that differ between two solutions of the clues
+    std::vector<bool> m_ambiguous;    // per cell (col + row * numCols)
+
     // scroll
     QScrollArea *m_pScrollArea;
 
@@ -39,9 +43,11 @@ class KkrBoardView : public QWidget
      * coord conversion
      */
     // cell coord -> widget code
-    QRect getCellRect(int col, int row) const;
-    QRect getClueRectRight(const QRect &cellRect) const;
-    QRect getClueRectDown(const QRect &cellRect) const;
+    QRect getCellRect(int col, int row) const {return BoardPainter::getCellRect(col, row);}
+
+    // repaint only the given cells (cell coord)
+    void updateCells(const QRect &cells) {update(BoardPainter::getBlockRect(cells));}
+    void updateCursorCell() {updateCells(QRect(m_curCol, m_curRow, 1, 1));}
 
     /*
      * drawing
@@ -49,6 +55,10 @@ class KkrBoardView : public QWidget
     void drawCell(QPainter &p, int col, int row) const;
     void showCell(int col, int row);
     void resetCursor(int col, int row, CursorClue cl = CursorClue::None);
+        // the selection shrinks to the cursor
+    void extendSelection(int col, int row);
+        // moves the cursor and keeps the anchor
+    bool hasSelection() const {return m_anchorCol != m_curCol || m_anchorRow != m_curRow;}
 
     /*
      * key input
@@ -66,7 +76,11 @@ public:
 
     void setScrollArea(QScrollArea *pSA) {m_pScrollArea=pSA;}
 
-    bool isEdited() const {/*TODO*/return false;}
+    QRect getSelection() const;
+        // in cell coord; the cursor cell without a selection
+    bool transformSelection(KkrBoardManager::Transform t);
+    bool applySymmetry(KkrBoardManager::Symmetry s);
+        // false if the selection or the board does not fit; see KkrBoardManager
 
 protected:
     void paintEvent(QPaintEvent *e) override;
@@ -76,6 +90,16 @@ signals:
 
 public slots:
     void slReset();
+    void slSetAmbiguousCells(const std::vector<int> &cells);
+        // replaces the previous ones; empty to clear
+
+    // bulk edits of the selection
+    void slSelectionToClues();
+    void slSelectionToAnswers();
+    void slClearSelection();
+    void slCopySelection();
+    void slPaste();
+        // at the top left of the selection
 };
 
 #endif // KKRWORKBOARD_H
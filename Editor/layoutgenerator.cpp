@@ -0,0 +1,160 @@
+#include "layoutgenerator.h"
+#include <algorithm>
+
+LayoutGenerator::LayoutGenerator(int cols, int rows, int density, Symmetry symmetry, unsigned seed)
+    : m_cols(cols)
+    , m_rows(rows)
+    , m_density(density)
+    , m_symmetry(symmetry)
+    , m_random(seed)
+{
+}
+
+bool LayoutGenerator::isAnswer(int col, int row) const
+{
+    return 0 <= col && col < m_cols && 0 <= row && row < m_rows
+            && m_clue[col + row * m_cols] == 0;
+}
+
+void LayoutGenerator::setClue(int col, int row)
+{
+    m_clue[col + row * m_cols] = 1;
+    switch(m_symmetry) {
+    case Symmetry::None:
+        break;
+    case Symmetry::Point:
+        m_clue[(m_cols-1-col) + (m_rows-1-row) * m_cols] = 1;
+        break;
+    case Symmetry::Rotational:
+        // square
+        m_clue[(m_cols-1-row) + col * m_cols] = 1;
+        m_clue[(m_cols-1-col) + (m_rows-1-row) * m_cols] = 1;
+        m_clue[row + (m_cols-1-col) * m_cols] = 1;
+        break;
+    }
+}
+
+bool LayoutGenerator::fixRuns()
+{
+    bool changed = false;
+    for(int dir = 0; dir < 2; ++dir) {
+        const int numLines = dir == 0 ? m_rows : m_cols;
+        const int lineLength = dir == 0 ? m_cols : m_rows;
+        for(int line = 0; line < numLines; ++line) {
+            int pos = 0;
+            while(pos < lineLength) {
+                const int col = dir == 0 ? pos : line;
+                const int row = dir == 0 ? line : pos;
+                if(!isAnswer(col, row)) {
+                    ++pos;
+                    continue;
+                }
+                int length = 1;
+                while(isAnswer(dir == 0 ? col+length : col, dir == 0 ? row : row+length))
+                    ++length;
+
+                if(length == 1) {
+                    setClue(col, row);
+                    changed = true;
+                } else if(length > MAX_RUN) {
+                    // both parts keep 2 cells or more
+                    const int split = std::uniform_int_distribution<int>(2, length-3)(m_random);
+                    setClue(dir == 0 ? col+split : col, dir == 0 ? row : row+split);
+                    changed = true;
+                }
+                pos += length;
+            }
+        }
+    }
+    return changed;
+}
+
+void LayoutGenerator::keepLargestArea()
+{
+    const int numCells = m_cols * m_rows;
+    m_component.assign(numCells, -1);
+    std::vector<int> sizes;
+
+    for(int start = 0; start < numCells; ++start) {
+        if(m_clue[start] != 0 || m_component[start] >= 0)
+            continue;
+        const int id = static_cast<int>(sizes.size());
+        m_queue.clear();
+        m_queue.push_back(start);
+        m_component[start] = id;
+        for(std::size_t head = 0; head < m_queue.size(); ++head) {
+            const int i = m_queue[head];
+            const int col = i % m_cols;
+            const int row = i / m_cols;
+            const int neighbours[4][2] = {{col-1, row}, {col+1, row}, {col, row-1}, {col, row+1}};
+            for(const auto &n : neighbours) {
+                if(!isAnswer(n[0], n[1]))
+                    continue;
+                const int ni = n[0] + n[1] * m_cols;
+                if(m_component[ni] < 0) {
+                    m_component[ni] = id;
+                    m_queue.push_back(ni);
+                }
+            }
+        }
+        sizes.push_back(static_cast<int>(m_queue.size()));
+    }
+    if(sizes.size() < 2)
+        return;
+
+    const int largest = static_cast<int>(std::max_element(sizes.begin(), sizes.end()) - sizes.begin());
+    for(int i = 0; i < numCells; ++i)
+        if(m_component[i] >= 0 && m_component[i] != largest)
+            m_clue[i] = 1;
+}
+
+bool LayoutGenerator::isSymmetric() const
+{
+    if(m_symmetry == Symmetry::None)
+        return true;
+    for(int row = 0; row < m_rows; ++row) {
+        for(int col = 0; col < m_cols; ++col) {
+            // rotational layouts are point symmetric too
+            const std::uint8_t clue = m_clue[col + row * m_cols];
+            if(m_clue[(m_cols-1-col) + (m_rows-1-row) * m_cols] != clue)
+                return false;
+            if(m_symmetry == Symmetry::Rotational && m_clue[(m_cols-1-row) + col * m_cols] != clue)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool LayoutGenerator::generate(std::vector<std::uint8_t> &layout)
+{
+    if(m_cols < 2 || m_rows < 2)
+        return false;
+    if(m_symmetry == Symmetry::Rotational && m_cols != m_rows)
+        return false;
+
+    const int numCells = m_cols * m_rows;
+    m_clue.assign(numCells, 0);
+
+    // scattered clue cells; each placement sets its images too
+    const int numImages = m_symmetry == Symmetry::Rotational ? 4 : m_symmetry == Symmetry::Point ? 2 : 1;
+    const int numPlaced = numCells * m_density / 100 / numImages;
+    std::uniform_int_distribution<int> anyCell(0, numCells-1);
+    for(int k = 0; k < numPlaced; ++k) {
+        const int i = anyCell(m_random);
+        setClue(i % m_cols, i / m_cols);
+    }
+
+    while(fixRuns())
+        ;
+    keepLargestArea();
+    if(!isSymmetric())
+        return false;
+
+    // too little left of the answer area
+    const int numAnswers = static_cast<int>(std::count(m_clue.begin(), m_clue.end(), 0));
+    if(numAnswers == 0 || numAnswers < numCells * (100 - m_density) / 200)
+        return false;
+
+    layout = m_clue;
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef LAYOUTGENERATOR_H
+#define LAYOUTGENERATOR_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*
+ * Random layouts of clue and answer cells
+ * A candidate starts with clue cells scattered at the requested density.
+ * Runs of one cell are then closed and runs over 9 cells split until every
+ * run has 2-9 cells, and answer cells cut off from the largest area are
+ * closed as well. Cells only ever turn into clue cells, so a candidate
+ * takes a few passes over the board. Candidates that lose the symmetry or
+ * most of their answer cells on the way are rejected.
+ */
+class LayoutGenerator
+{
+public:
+    enum class Symmetry {
+        None, Point, Rotational
+    };
+        // about the center: by 180 and by 90 degrees
+
+    LayoutGenerator(int cols, int rows, int density, Symmetry symmetry, unsigned seed);
+        // size of the answer area; density in percent of clue cells
+        // Rotational needs a square area
+
+    LayoutGenerator(const LayoutGenerator &) = delete;
+    LayoutGenerator &operator=(const LayoutGenerator &) = delete;
+
+    bool generate(std::vector<std::uint8_t> &layout);
+        // one candidate; false if rejected
+        // layout per cell (col + row * cols): 1 for clue cells, 0 for answer cells
+
+private:
+    static const int MAX_RUN = 9;
+
+    int m_cols;
+    int m_rows;
+    int m_density;
+    Symmetry m_symmetry;
+    std::mt19937 m_random;
+
+    std::vector<std::uint8_t> m_clue;     // per cell
+    std::vector<int> m_component;         // per cell; -1 for clue cells
+    std::vector<int> m_queue;
+
+    bool isAnswer(int col, int row) const;
+        // false outside the area
+    void setClue(int col, int row);
+        // and its images
+    bool fixRuns();
+        // one pass in both directions; true if a cell changed
+    void keepLargestArea();
+    bool isSymmetric() const;
+};
+
+#endif // LAYOUTGENERATOR_H
@@ -17,26 +17,31 @@ MetaDataManager::MetaDataManager(QObject *parent)
 void MetaDataManager::setAuthor(const QString &newAuthor)
 {
     m_author = newAuthor;
+    emit sigEdited();
 }
 
 void MetaDataManager::setBeginnerTime(int begin)
 {
     m_beginner = begin;
+    emit sigEdited();
 }
 
 void MetaDataManager::setIntermediateTime(int inter)
 {
     m_intermediate = inter;
+    emit sigEdited();
 }
 
 void MetaDataManager::setAdvancedTime(int advan)
 {
     m_advanced = advan;
+    emit sigEdited();
 }
 
 void MetaDataManager::setExpertTime(int expert)
 {
     m_expert = expert;
+    emit sigEdited();
 }
 
 bool MetaDataManager::isValid() const
@@ -40,6 +40,8 @@ public:
 
 signals:
     void sigReset();
+    void sigEdited();
+        // any change by the view
 
 public slots:
     void slCreate();
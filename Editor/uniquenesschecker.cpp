@@ -0,0 +1,73 @@
+#include "uniquenesschecker.h"
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+namespace {
+
+UniquenessChecker::Outcome check(std::shared_ptr<const BoardData> pData,
+                                 std::shared_ptr<std::atomic_bool> pCancel)
+{
+    KkrSolver solver{*pData};
+    UniquenessChecker::Outcome outcome;
+    outcome.result = solver.solve(pCancel.get());
+    outcome.differingCells = solver.getDifferingCells();
+    return outcome;
+}
+
+}   // namespace
+
+UniquenessChecker::UniquenessChecker(KkrBoardManager *pBoardData, QObject *parent)
+    : QObject(parent)
+    , m_pBoardData(pBoardData)
+    , m_generation(0)
+{
+    m_delay.setSingleShot(true);
+    m_delay.setInterval(DELAY_MSEC);
+    connect(&m_delay, &QTimer::timeout, this, &UniquenessChecker::startCheck);
+
+    connect(pBoardData, &KkrBoardManager::sigReset, this, &UniquenessChecker::slBoardChanged);
+    connect(pBoardData, &KkrBoardManager::sigCluesChanged, this, &UniquenessChecker::slBoardChanged);
+}
+
+UniquenessChecker::~UniquenessChecker()
+{
+    // the worker owns its snapshot; it only has to stop early
+    cancelCheck();
+}
+
+void UniquenessChecker::cancelCheck()
+{
+    if(m_pCancel)
+        m_pCancel->store(true);
+    m_pCancel.reset();
+}
+
+void UniquenessChecker::startCheck()
+{
+    // immutable snapshot for the worker; the board keeps changing on this thread
+    std::shared_ptr<const BoardData> pData{m_pBoardData->getBoardData()};
+    m_pCancel = std::make_shared<std::atomic_bool>(false);
+    const int generation = m_generation;
+
+    auto pWatcher = new QFutureWatcher<Outcome>(this);
+    connect(pWatcher, &QFutureWatcher<Outcome>::finished, this, [this, pWatcher, generation]() {
+        const Outcome outcome = pWatcher->result();
+        pWatcher->deleteLater();
+        if(generation == m_generation && outcome.result != KkrSolver::Result::Cancelled) {
+            m_pCancel.reset();
+            emit sigChecked(outcome.result, outcome.differingCells);
+        }
+    });
+    pWatcher->setFuture(QtConcurrent::run(check, pData, m_pCancel));
+}
+
+/*
+ * slots
+ */
+void UniquenessChecker::slBoardChanged()
+{
+    cancelCheck();
+    ++m_generation;
+    m_delay.start();
+    emit sigChecking();
+}
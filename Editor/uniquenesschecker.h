@@ -0,0 +1,57 @@
+#ifndef UNIQUENESSCHECKER_H
+#define UNIQUENESSCHECKER_H
+
+#include <QObject>
+#include <QTimer>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "kkrboardmanager.h"
+#include "kkrsolver.h"
+
+/*
+ * Background uniqueness check of the board being edited
+ * A check starts shortly after the layout or a clue changes, on a snapshot
+ * of the board in the global thread pool. Every change cancels the running
+ * check; results of stale checks are dropped, so only the latest board is
+ * ever reported.
+ */
+class UniquenessChecker : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Outcome {
+        KkrSolver::Result result;
+        std::vector<int> differingCells;    // col + row * numCols
+    };
+
+private:
+    static const int DELAY_MSEC = 300;
+        // edits within this period share one check
+
+    KkrBoardManager *m_pBoardData;
+    QTimer m_delay;
+    int m_generation;       // of the latest snapshot; older results are stale
+    std::shared_ptr<std::atomic_bool> m_pCancel;
+
+    void startCheck();
+    void cancelCheck();
+
+public:
+    explicit UniquenessChecker(KkrBoardManager *pBoardData, QObject *parent = 0);
+    ~UniquenessChecker();
+
+    UniquenessChecker(const UniquenessChecker &) = delete;
+    UniquenessChecker &operator=(const UniquenessChecker &) = delete;
+
+signals:
+    void sigChecking();
+        // the last result no longer applies
+    void sigChecked(KkrSolver::Result result, const std::vector<int> &differingCells);
+
+public slots:
+    void slBoardChanged();
+};
+
+#endif // UNIQUENESSCHECKER_H
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui
+QT       += core gui svg
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -15,21 +15,41 @@ TEMPLATE = app
 SOURCES += main.cpp\
         mainwindow.cpp \
     kkrboard.cpp \
+    navigationtable.cpp \
     problemdata.cpp \
     playstatus.cpp \
     useranswer.cpp \
     useranswermanager.cpp \
     inputdrag.cpp \
-    inputfactory.cpp
+    inputfactory.cpp \
+    answerjournal.cpp \
+    replayengine.cpp \
+    replaydialog.cpp \
+    answercheck.cpp \
+    boardrenderer.cpp \
+    boardexport.cpp \
+    ../Common/glyphatlas.cpp \
+    ../Common/boardpainter.cpp
 
 HEADERS  += mainwindow.h \
     kkrboard.h \
+    navigationtable.h \
     problemdata.h \
     playstatus.h \
     useranswer.h \
     useranswermanager.h \
-    cosmetic.h \
+    ../Common/cosmetic.h \
     inputfactory.h \
-    inputdrag.h
+    inputdrag.h \
+    answerjournal.h \
+    replayengine.h \
+    replaydialog.h \
+    answercheck.h \
+    boardrenderer.h \
+    boardexport.h \
+    ../Common/glyphatlas.h \
+    ../Common/boardpainter.h
+
+INCLUDEPATH += ../Common
 
 CONFIG += c++11
@@ -0,0 +1,82 @@
+#include "answercheck.h"
+#include "useranswer.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KKR_USE_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace useranswer {
+
+static inline int lowestBit(unsigned mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+    while((mask & 1) == 0) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+static inline void classify(const std::uint8_t *answers, int i, int baseIndex, CheckResult &result)
+{
+    if(answers[i] == ANSWER_NODATA)
+        result.empty.push_back(baseIndex + i);
+    else
+        result.wrong.push_back(baseIndex + i);
+}
+
+bool sameAnswers(const std::uint8_t *answers, const std::uint8_t *solution, int size)
+{
+    return std::memcmp(answers, solution, size) == 0;
+}
+
+void compareAnswers(const std::uint8_t *answers, const std::uint8_t *solution, int size,
+                    int baseIndex, CheckResult &result)
+{
+    int i = 0;
+
+#ifdef KKR_USE_SSE2
+    // 16 cells at a time; only blocks with a mismatch are looked into
+    for(; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(answers + i));
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(solution + i));
+        unsigned mismatch = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, s))) ^ 0xffffu;
+        while(mismatch != 0) {
+            classify(answers, i + lowestBit(mismatch), baseIndex, result);
+            mismatch &= mismatch - 1;
+        }
+    }
+#else
+    // 8 cells at a time
+    for(; i + 8 <= size; i += 8) {
+        std::uint64_t a, s;
+        std::memcpy(&a, answers + i, sizeof(a));
+        std::memcpy(&s, solution + i, sizeof(s));
+        if(a == s)
+            continue;
+        for(int j = i; j < i + 8; ++j)
+            if(answers[j] != solution[j])
+                classify(answers, j, baseIndex, result);
+    }
+#endif
+
+    for(; i < size; ++i)
+        if(answers[i] != solution[i])
+            classify(answers, i, baseIndex, result);
+}
+
+}   // namespace useranswer
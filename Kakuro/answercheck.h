@@ -0,0 +1,27 @@
+#ifndef ANSWERCHECK_H
+#define ANSWERCHECK_H
+
+#include <vector>
+#include <cstdint>
+
+namespace useranswer {
+
+struct CheckResult {
+    std::vector<int> wrong;     // cell indexes of wrong answers
+    std::vector<int> empty;     // cell indexes of answer cells without an answer
+
+    bool isSolved() const {return wrong.empty() && empty.empty();}
+    void clear() {wrong.clear(); empty.clear();}
+};
+
+bool sameAnswers(const std::uint8_t *answers, const std::uint8_t *solution, int size);
+    // fast path; true if all cells match
+
+void compareAnswers(const std::uint8_t *answers, const std::uint8_t *solution, int size,
+                    int baseIndex, CheckResult &result);
+    // appends mismatching cells to result; indexes are offset by baseIndex
+    // solution has 0 in clue cells, same as answers, so only answer cells can mismatch
+
+}   // namespace useranswer
+
+#endif // ANSWERCHECK_H
@@ -0,0 +1,184 @@
+#include "answerjournal.h"
+#include <cstring>
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace useranswer {
+
+/*
+ * file format
+ *  header: "KKRJ" "0001" cols(2 bytes) rows(2 bytes)
+ *  record: time(8) col(2) row(2) answer(1) op(1) reserved(1) checksum(1)
+ *  all integers are big endian
+ */
+static const char JOURNAL_SIG[] = {'K', 'K', 'R', 'J'};
+static const char JOURNAL_VER[] = {'0', '0', '0', '1'};
+static const int HEADER_SIZE = 12;
+static const int RECORD_SIZE = 16;
+static const unsigned char CHECKSUM_SEED = 0xa5;
+    // an all-zero record (e.g. a block not written before power loss) never validates
+
+static unsigned char checksum(const unsigned char *rec)
+{
+    unsigned char sum = 0;
+    for(int i = 0; i < RECORD_SIZE-1; ++i)
+        sum += rec[i];
+    return sum ^ CHECKSUM_SEED;
+}
+
+static void encodeRecord(const JournalRecord &rec, unsigned char *buffer)
+{
+    const quint64 t = static_cast<quint64>(rec.time);
+    for(int i = 0; i < 8; ++i)
+        buffer[i] = static_cast<unsigned char>(t >> (56 - 8*i));
+    buffer[8] = static_cast<unsigned char>(rec.col >> 8);
+    buffer[9] = static_cast<unsigned char>(rec.col);
+    buffer[10] = static_cast<unsigned char>(rec.row >> 8);
+    buffer[11] = static_cast<unsigned char>(rec.row);
+    buffer[12] = static_cast<unsigned char>(rec.answer);
+    buffer[13] = (rec.op == JournalOp::Undo ? 1 : 0);
+    buffer[14] = 0;
+    buffer[15] = checksum(buffer);
+}
+
+static bool decodeRecord(const unsigned char *buffer, JournalRecord &rec)
+{
+    if(buffer[15] != checksum(buffer) || buffer[13] > 1)
+        return false;
+
+    quint64 t = 0;
+    for(int i = 0; i < 8; ++i)
+        t = (t << 8) | buffer[i];
+    rec.time = static_cast<qint64>(t);
+    rec.col = buffer[8] * 256 + buffer[9];
+    rec.row = buffer[10] * 256 + buffer[11];
+    rec.answer = buffer[12];
+    rec.op = (buffer[13] == 1 ? JournalOp::Undo : JournalOp::Update);
+    return true;
+}
+
+AnswerJournal::AnswerJournal(const QString &filename)
+    : m_file(filename)
+    , m_unsynced(0)
+{
+}
+
+AnswerJournal::~AnswerJournal()
+{
+    if(m_file.isOpen()) {
+        sync();
+        m_file.close();
+    }
+}
+
+bool AnswerJournal::create(int numCols, int numRows)
+{
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    unsigned char header[HEADER_SIZE];
+    std::memcpy(header, JOURNAL_SIG, sizeof(JOURNAL_SIG));
+    std::memcpy(header+4, JOURNAL_VER, sizeof(JOURNAL_VER));
+    header[8] = static_cast<unsigned char>(numCols >> 8);
+    header[9] = static_cast<unsigned char>(numCols);
+    header[10] = static_cast<unsigned char>(numRows >> 8);
+    header[11] = static_cast<unsigned char>(numRows);
+    if(m_file.write(reinterpret_cast<const char *>(header), HEADER_SIZE) != HEADER_SIZE)
+        return false;
+
+    ++m_unsynced;
+    sync();
+    return true;
+}
+
+bool AnswerJournal::openAppend(int numRecords)
+{
+    if(!m_file.open(QIODevice::ReadWrite))
+        return false;
+
+    // drop torn or broken records left by a crash so that new records follow valid ones
+    const qint64 validSize = HEADER_SIZE + static_cast<qint64>(numRecords) * RECORD_SIZE;
+    if(m_file.size() != validSize && !m_file.resize(validSize))
+        return false;
+
+    return m_file.seek(validSize);
+}
+
+void AnswerJournal::append(const JournalRecord &rec)
+{
+    if(!m_file.isOpen())
+        return;
+
+    unsigned char buffer[RECORD_SIZE];
+    encodeRecord(rec, buffer);
+    m_file.write(reinterpret_cast<const char *>(buffer), RECORD_SIZE);
+
+    if(++m_unsynced >= SYNC_BATCH)
+        sync();
+}
+
+void AnswerJournal::sync()
+{
+    if(!m_file.isOpen() || m_unsynced == 0)
+        return;
+
+    m_file.flush();
+#ifdef Q_OS_WIN
+    _commit(m_file.handle());
+#else
+    ::fsync(m_file.handle());
+#endif
+    m_unsynced = 0;
+}
+
+bool AnswerJournal::archive(const QString &newName)
+{
+    sync();
+    m_file.close();
+    if(!m_file.rename(newName)) {
+        // never leave a finished play behind to be recovered
+        m_file.remove();
+        return false;
+    }
+    return true;
+}
+
+bool AnswerJournal::readJournal(const QString &filename, int numCols, int numRows,
+                                std::vector<JournalRecord> &records)
+{
+    QFile f{filename};
+    if(!f.open(QIODevice::ReadOnly))
+        return false;
+
+    // read everything at once; a million records are only 16MB
+    const QByteArray data{f.readAll()};
+    if(data.size() < HEADER_SIZE)
+        return false;
+
+    const unsigned char * const bytes = reinterpret_cast<const unsigned char *>(data.constData());
+    if(std::memcmp(bytes, JOURNAL_SIG, sizeof(JOURNAL_SIG)) != 0
+            || std::memcmp(bytes+4, JOURNAL_VER, sizeof(JOURNAL_VER)) != 0)
+        return false;
+    if(bytes[8] * 256 + bytes[9] != numCols || bytes[10] * 256 + bytes[11] != numRows)
+        return false;
+
+    const int numRecords = (data.size() - HEADER_SIZE) / RECORD_SIZE;
+    records.clear();
+    records.reserve(numRecords);
+
+    JournalRecord rec;
+    for(int i = 0; i < numRecords; ++i) {
+        if(!decodeRecord(bytes + HEADER_SIZE + i * RECORD_SIZE, rec))
+            break;  // anything after a broken record is not trustworthy
+        if(rec.col >= numCols || rec.row >= numRows || rec.answer > 9)
+            break;
+        records.push_back(rec);
+    }
+
+    return true;
+}
+
+}   // namespace useranswer
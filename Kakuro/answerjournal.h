@@ -0,0 +1,62 @@
+#ifndef ANSWERJOURNAL_H
+#define ANSWERJOURNAL_H
+
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+namespace useranswer {
+
+enum class JournalOp {
+    Update,
+    Undo
+};
+
+struct JournalRecord {
+    qint64 time;    // elapsed play time in msec
+    int col;
+    int row;
+    int answer;     // value of the cell after the operation
+    JournalOp op;
+};
+
+/*
+ * Append-only log of the user's moves
+ * Records are written through the buffered file and fsync'ed every SYNC_BATCH
+ * records (or on sync()), so a power loss costs at most one batch of moves.
+ */
+class AnswerJournal
+{
+    QFile m_file;
+    int m_unsynced;     // # of records written since the last fsync
+
+public:
+    static const int SYNC_BATCH = 32;
+
+    explicit AnswerJournal(const QString &filename);
+    ~AnswerJournal();
+
+    AnswerJournal(const AnswerJournal&) = delete;
+    AnswerJournal &operator=(const AnswerJournal&) = delete;
+
+    bool create(int numCols, int numRows);
+        // truncate the file and write the header
+    bool openAppend(int numRecords);
+        // continue an existing journal after the first numRecords valid records
+        // the header must have been verified by readJournal()
+    void append(const JournalRecord &rec);
+    void sync();
+        // flush buffered records and fsync the file
+    bool archive(const QString &newName);
+        // close the journal and keep it as a recorded play under newName
+
+    static bool readJournal(const QString &filename, int numCols, int numRows,
+                            std::vector<JournalRecord> &records);
+        // read all complete records; a torn record at the tail is ignored
+        // returns false if the file does not exist or belongs to another board size
+};
+
+}   // namespace useranswer
+
+#endif // ANSWERJOURNAL_H
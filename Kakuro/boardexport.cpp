@@ -0,0 +1,147 @@
+#include "boardexport.h"
+#include <QSvgGenerator>
+#include <algorithm>
+
+namespace pd = problemdata;
+
+namespace {
+
+// QPdfWriter resolution; 72 dpi makes device pixels equal points
+const int PDF_RESOLUTION = 72;
+
+}   // namespace
+
+bool exportSvg(const pd::ProblemData &data, const QString &fileName, const std::uint8_t *pAnswers)
+{
+    const QSize boardSize{BoardRenderer::getBoardSize(data.getNumCols(), data.getNumRows())};
+
+    QSvgGenerator svg;
+    svg.setFileName(fileName);
+    svg.setSize(boardSize);
+    svg.setViewBox(QRect(QPoint(0, 0), boardSize));
+    svg.setResolution(PDF_RESOLUTION);
+    svg.setTitle(QStringLiteral("Kakuro"));
+
+    QPainter p;
+    if(!p.begin(&svg))
+        return false;
+    p.fillRect(QRect(QPoint(0, 0), boardSize), Qt::white);
+    const BoardRenderer renderer{BoardRenderer::TextMode::Text};
+    renderer.paintBoard(p, data, pAnswers);
+    return p.end();
+}
+
+bool exportPdf(const pd::ProblemData &data, const QString &fileName, const std::uint8_t *pAnswers)
+{
+    const QSize boardSize{BoardRenderer::getBoardSize(data.getNumCols(), data.getNumRows())};
+
+    QPdfWriter pdf{fileName};
+    pdf.setResolution(PDF_RESOLUTION);
+    pdf.setPageSize(QPageSize(QSizeF(boardSize), QPageSize::Point));
+    pdf.setPageMargins(QMarginsF(0, 0, 0, 0), QPageLayout::Point);
+    pdf.setTitle(QStringLiteral("Kakuro"));
+
+    QPainter p;
+    if(!p.begin(&pdf))
+        return false;
+    const BoardRenderer renderer{BoardRenderer::TextMode::Text};
+    renderer.paintBoard(p, data, pAnswers);
+    return p.end();
+}
+
+/*
+ * BookletWriter
+ */
+BookletOptions::BookletOptions()
+    : cols(2)
+    , rows(2)
+    , pageSize(QPageSize::A4)
+    , margins(36, 36, 36, 36)
+    , withSolution(false)
+    , numbered(true)
+{
+}
+
+BookletWriter::BookletWriter(const QString &fileName, const BookletOptions &options)
+    : m_options(options)
+    , m_pWriter(new QPdfWriter(fileName))
+    , m_renderer(BoardRenderer::TextMode::Text)
+    , m_numProblems(0)
+{
+    m_options.cols = std::max(m_options.cols, 1);
+    m_options.rows = std::max(m_options.rows, 1);
+
+    m_pWriter->setResolution(PDF_RESOLUTION);
+    m_pWriter->setPageSize(m_options.pageSize);
+    m_pWriter->setPageMargins(m_options.margins, QPageLayout::Point);
+    m_pWriter->setTitle(QStringLiteral("Kakuro"));
+    m_painter.begin(m_pWriter.get());
+}
+
+BookletWriter::~BookletWriter()
+{
+    finish();
+}
+
+QRectF BookletWriter::getSlotRect(int slot) const
+{
+    // painter origin is at the top left of the printable area
+    const QRectF page{QPointF(0, 0),
+                      m_pWriter->pageLayout().paintRect(QPageLayout::Point).size()};
+    const qreal slotWidth = (page.width() - SLOT_SPACING * (m_options.cols - 1)) / m_options.cols;
+    const qreal slotHeight = (page.height() - SLOT_SPACING * (m_options.rows - 1)) / m_options.rows;
+    const int col = slot % m_options.cols;
+    const int row = slot / m_options.cols;
+    return QRectF(col * (slotWidth + SLOT_SPACING), row * (slotHeight + SLOT_SPACING),
+                  slotWidth, slotHeight);
+}
+
+bool BookletWriter::addProblem(const pd::ProblemData &data)
+{
+    if(!isOpen())
+        return false;
+
+    const int perPage = m_options.cols * m_options.rows;
+    const int slot = m_numProblems % perPage;
+    if(slot == 0 && m_numProblems > 0 && !m_pWriter->newPage())
+        return false;
+
+    QRectF area{getSlotRect(slot)};
+    if(m_options.numbered) {
+        QFont font{FONT_CLUE};
+        font.setPixelSize(CAPTION_HEIGHT - 2);
+        m_painter.setFont(font);
+        m_painter.setPen(Qt::black);
+        m_painter.drawText(QRectF(area.left(), area.top(), area.width(), CAPTION_HEIGHT),
+                           Qt::AlignLeft | Qt::AlignVCenter, QString::number(m_numProblems + 1));
+        area.setTop(area.top() + CAPTION_HEIGHT);
+    }
+
+    // fit the board in the slot, centred, never enlarged
+    const QSize boardSize{BoardRenderer::getBoardSize(data.getNumCols(), data.getNumRows())};
+    const qreal scale = std::min({area.width() / boardSize.width(),
+                                  area.height() / boardSize.height(), 1.0});
+    const QSizeF scaled{boardSize.width() * scale, boardSize.height() * scale};
+
+    m_painter.save();
+    m_painter.translate(area.left() + (area.width() - scaled.width()) / 2, area.top());
+    m_painter.scale(scale, scale);
+    m_renderer.paintBoard(m_painter, data, m_options.withSolution ? data.getSolution() : nullptr);
+    m_painter.restore();
+
+    ++m_numProblems;
+    return true;
+}
+
+bool BookletWriter::finish()
+{
+    if(!isOpen())
+        return false;
+    return m_painter.end();
+}
+
+int BookletWriter::getNumPages() const
+{
+    const int perPage = m_options.cols * m_options.rows;
+    return std::max((m_numProblems + perPage - 1) / perPage, 1);
+}
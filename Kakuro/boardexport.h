@@ -0,0 +1,71 @@
+#ifndef BOARDEXPORT_H
+#define BOARDEXPORT_H
+
+#include <QMarginsF>
+#include <QPageSize>
+#include <QPdfWriter>
+#include <QPainter>
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include "boardrenderer.h"
+#include "problemdata.h"
+
+/*
+ * Vector export
+ * Same geometry as the board view; one board coord unit is one point, so
+ * a cell is half an inch wide. Digits are written as text.
+ */
+bool exportSvg(const problemdata::ProblemData &data, const QString &fileName,
+               const std::uint8_t *pAnswers = nullptr);
+bool exportPdf(const problemdata::ProblemData &data, const QString &fileName,
+               const std::uint8_t *pAnswers = nullptr);
+    // pAnswers as in BoardRenderer::paintBoard()
+
+/*
+ * Booklet: puzzles laid out on a grid of slots on each page
+ * Each page is written out when the next one starts, so only the current
+ * page is kept in memory; add problems one at a time and drop them after.
+ */
+struct BookletOptions {
+    int cols;               // slots per page across
+    int rows;               // slots per page down
+    QPageSize pageSize;
+    QMarginsF margins;      // in points
+    bool withSolution;
+    bool numbered;          // caption every puzzle with its number
+
+    BookletOptions();
+};
+
+class BookletWriter
+{
+    static const int SLOT_SPACING = 18;     // in points
+    static const int CAPTION_HEIGHT = 14;   // in points
+
+    BookletOptions m_options;
+    std::unique_ptr<QPdfWriter> m_pWriter;
+    QPainter m_painter;
+    BoardRenderer m_renderer;
+    int m_numProblems;
+
+    QRectF getSlotRect(int slot) const;
+
+public:
+    BookletWriter(const QString &fileName, const BookletOptions &options);
+    ~BookletWriter();
+
+    BookletWriter(const BookletWriter&) = delete;
+    BookletWriter &operator=(const BookletWriter&) = delete;
+
+    bool isOpen() const {return m_painter.isActive();}
+    bool addProblem(const problemdata::ProblemData &data);
+        // starts a new page when the current one is full
+    bool finish();
+        // write the last page and close the file; called by the destructor too
+
+    int getNumProblems() const {return m_numProblems;}
+    int getNumPages() const;
+};
+
+#endif // BOARDEXPORT_H
@@ -0,0 +1,109 @@
+#include "boardrenderer.h"
+#include <QtMath>
+
+namespace pd = problemdata;
+
+BoardRenderer::BoardRenderer(TextMode textMode)
+    : BoardPainter(textMode)
+{
+}
+
+/*
+ * painting
+ */
+void BoardRenderer::paintStatic(QPainter &p, const pd::ProblemData &data, const QRect &area,
+                                bool showDigits) const
+{
+    paintFrame(p, data.getNumCols(), data.getNumRows(), area);
+    paintBorders(p, data.getNumCols(), data.getNumRows(), area);
+
+    const QRect range{getCellRange(data, area)};
+    if(range.isEmpty())
+        return;
+
+    for(int y = range.top(); y <= range.bottom(); ++y)
+        for(int x = range.left(); x <= range.right(); ++x)
+            if(data.getCellType(x, y) == pd::CellType::CellClue)
+                drawClueCell(p, data, x, y, showDigits);
+}
+
+void BoardRenderer::paintStaticLod(QPainter &p, const pd::ProblemData &data, const QRect &area,
+                                   bool showGrid) const
+{
+    paintFrame(p, data.getNumCols(), data.getNumRows(), area);
+
+    const QRect range{getCellRange(data, area)};
+    if(range.isEmpty())
+        return;
+
+    // a run of clue cells in a row is one block including the borders between them
+    const int cellFrameWidth = CELL_WIDTH + BORDER_THICK;
+    for(int y = range.top(); y <= range.bottom(); ++y) {
+        for(int x = range.left(); x <= range.right(); ++x) {
+            if(data.getCellType(x, y) != pd::CellType::CellClue)
+                continue;
+            const int first = x;
+            while(x < range.right() && data.getCellType(x+1, y) == pd::CellType::CellClue)
+                ++x;
+            const QRect cellRect{getCellRect(first, y)};
+            p.fillRect(cellRect.x(), cellRect.y(), (x-first+1) * cellFrameWidth, cellFrameWidth,
+                       getBrush(Fill::Foreground));
+        }
+    }
+
+    // grid lines while cells are still large enough to tell apart
+    if(showGrid)
+        paintGrid(p, data.getNumCols(), data.getNumRows(), area);
+}
+
+void BoardRenderer::drawClueCell(QPainter &p, const pd::ProblemData &data, int col, int row,
+                                 bool showDigits) const
+{
+    // closed clues are 0 in problem data
+    const int right = data.getClueRight(col, row);
+    const int down = data.getClueDown(col, row);
+    BoardPainter::drawClueCell(p, col, row,
+                               right == pd::CLOSED_CLUE ? CLOSED_CLUE : right,
+                               down == pd::CLOSED_CLUE ? CLOSED_CLUE : down,
+                               showDigits);
+}
+
+void BoardRenderer::paintBoard(QPainter &p, const pd::ProblemData &data,
+                               const std::uint8_t *pAnswers, bool detailed) const
+{
+    const QSize boardSize{getBoardSize(data.getNumCols(), data.getNumRows())};
+    const QRect area{QPoint(0, 0), boardSize};
+
+    if(!detailed) {
+        const qreal scale = p.worldTransform().m11();
+        paintStaticLod(p, data, area, scale >= 0.25);
+        return;
+    }
+
+    paintStatic(p, data, area, true);
+    if(pAnswers != nullptr) {
+        for(int row = 0; row < data.getNumRows(); ++row) {
+            for(int col = 0; col < data.getNumCols(); ++col) {
+                const int ans = pAnswers[col + row * data.getNumCols()];
+                if(ans != 0 && data.getCellType(col, row) == pd::CellType::CellAnswer)
+                    drawAnswer(p, col, row, ans);
+            }
+        }
+    }
+}
+
+QImage BoardRenderer::render(const pd::ProblemData &data, const std::uint8_t *pAnswers, qreal scale) const
+{
+    const QSize boardSize{getBoardSize(data.getNumCols(), data.getNumRows())};
+    QImage image(QSize(qCeil(boardSize.width() * scale), qCeil(boardSize.height() * scale)),
+                 QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    QPainter p(&image);
+    p.scale(scale, scale);
+
+    // digits are unreadable below half size; thumbnails show the cell types only
+    paintBoard(p, data, pAnswers, scale >= 0.5);
+
+    return image;
+}
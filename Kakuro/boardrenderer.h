@@ -0,0 +1,54 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <QImage>
+#include <QPainter>
+#include <QPoint>
+#include <QRect>
+#include <cstdint>
+#include "boardpainter.h"
+#include "problemdata.h"
+
+/*
+ * Draws a problem with QPainter, independent of any widget
+ * Adds ProblemData aware layers on top of the shared BoardPainter.
+ */
+class BoardRenderer : public BoardPainter
+{
+public:
+    explicit BoardRenderer(TextMode textMode = TextMode::Glyphs);
+
+    /*
+     * geometry
+     */
+    using BoardPainter::getCellCoord;
+    using BoardPainter::getCellRange;
+    static QPoint getCellCoord(const problemdata::ProblemData &data, int x, int y)
+        {return getCellCoord(data.getNumCols(), data.getNumRows(), x, y);}
+    static QRect getCellRange(const problemdata::ProblemData &data, const QRect &rect)
+        {return getCellRange(data.getNumCols(), data.getNumRows(), rect);}
+
+    /*
+     * painting; area is in board coord
+     */
+    void paintStatic(QPainter &p, const problemdata::ProblemData &data, const QRect &area,
+                     bool showDigits) const;
+        // frame, borders and clue cells intersecting area
+    void paintStaticLod(QPainter &p, const problemdata::ProblemData &data, const QRect &area,
+                        bool showGrid) const;
+        // frame and clue cells as plain blocks for small scales
+    void drawClueCell(QPainter &p, const problemdata::ProblemData &data, int col, int row,
+                      bool showDigits) const;
+
+    void paintBoard(QPainter &p, const problemdata::ProblemData &data,
+                    const std::uint8_t *pAnswers = nullptr, bool detailed = true) const;
+        // the whole board without the background
+        // pAnswers is one byte per cell in row major order, e.g. ProblemData::getSolution();
+        // nullptr paints a blank puzzle; answers are not painted unless detailed
+
+    QImage render(const problemdata::ProblemData &data, const std::uint8_t *pAnswers = nullptr,
+                  qreal scale = 1.0) const;
+        // the whole board on a white background; see paintBoard()
+};
+
+#endif // BOARDRENDERER_H
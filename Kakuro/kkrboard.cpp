@@ -1,21 +1,27 @@
 #include "kkrboard.h"
 #include <QPainter>
 #include <QPalette>
-#include <QFont>
-#include <array>
+#include <QPaintEvent>
+#include <QKeyEvent>
+#include <QResizeEvent>
+#include <QtMath>
+#include <algorithm>
 #include "inputfactory.h"
 
+const qreal KkrBoard::ZOOM_LEVELS[KkrBoard::NUM_ZOOM_LEVELS] = {
+    0.0625, 0.125, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0
+};
+
 KkrBoard::KkrBoard(QWidget *parent)
-    : QWidget(parent)
-    , m_fontAns(FONT_ANS)
-    , m_fontClue(FONT_CLUE)
+    : QAbstractScrollArea(parent)
+    , m_board_width(0)
+    , m_board_height(0)
     , m_showDigits(false)
     , m_acceptInput(false)
-    , m_pScrollArea(nullptr)
+    , m_zoomLevel(DEFAULT_ZOOM_LEVEL)
+    , m_pyramid(NUM_ZOOM_LEVELS)
 {
     m_pCellInput = cellInputFactory(this);
-    m_fontAns.setPixelSize(CELL_WIDTH);
-    m_fontClue.setPixelSize(CLUE_WIDTH);
     setFocusPolicy(Qt::StrongFocus);
 }
 
@@ -32,28 +38,31 @@ void KkrBoard::updateProblem(std::shared_ptr<problemdata::ProblemData> pNewData)
     m_showDigits = false;
     m_acceptInput = false;
     m_pData = pNewData;
+    m_mistakes.assign(m_pData->getNumCols() * m_pData->getNumRows(), 0);
+    m_mistakeCells.clear();
 
-    for(m_curRow = 1; m_curRow < m_pData->getNumRows(); ++m_curRow)
-        for(m_curCol = 1; m_curCol < m_pData->getNumCols(); ++m_curCol)
-            if(m_pData->getCellType(m_curCol, m_curRow) == pd::CellType::CellAnswer)
-                goto found;
-    found:
+    m_nav.build(*m_pData);
+    const int firstCell = m_nav.getFirstCell();
+    // a board without answer cells keeps the cursor on the corner clue
+    m_curCol = firstCell == NavigationTable::NO_CELL ? 0 : firstCell % m_pData->getNumCols();
+    m_curRow = firstCell == NavigationTable::NO_CELL ? 0 : firstCell / m_pData->getNumCols();
 
     // calculate sizes
-    m_inner_width = (CELL_WIDTH + BORDER_THICK) * m_pData->getNumCols() - BORDER_THICK;
-    m_inner_height = (CELL_WIDTH + BORDER_THICK) * m_pData->getNumRows() - BORDER_THICK;
-    m_frame_width = 2*FRAME_THICK + m_inner_width;
-    m_frame_height = 2*FRAME_THICK + m_inner_height;
-    m_board_width = 2*MARGIN + m_frame_width;
-    m_board_height = 2*MARGIN + m_frame_height;
+    const QSize boardSize{BoardRenderer::getBoardSize(m_pData->getNumCols(), m_pData->getNumRows())};
+    m_board_width = boardSize.width();
+    m_board_height = boardSize.height();
 
-    setFixedSize(m_board_width, m_board_height);
+    updateScrollBars();
+    horizontalScrollBar()->setValue(0);
+    verticalScrollBar()->setValue(0);
 
-    update();
+    invalidateStaticLayer();
+    viewport()->update();
 }
 
 void KkrBoard::updateStatus(playstatus::Status newStatus)
 {
+    const bool showDigits = m_showDigits;
     switch(newStatus) {
     case playstatus::Status::INPLAY:
         m_showDigits = true;
@@ -67,18 +76,65 @@ void KkrBoard::updateStatus(playstatus::Status newStatus)
         m_showDigits = false;
         m_acceptInput = false;
     }
-    update();
+    // clue digits are in the static layer
+    if(m_showDigits != showDigits)
+        invalidateStaticLayer();
+    viewport()->update();
 }
 
 void KkrBoard::updateUserAnswer(useranswer::SharedAnswer pNewAns)
 {
     m_pAns = pNewAns;
     // no update();
+
+    if(m_pData == nullptr || m_pAns->getNumCols() != m_pData->getNumCols()
+            || m_pAns->getNumRows() != m_pData->getNumRows())
+        return;
+    for(int k = 0; k < m_pAns->getNumChunks(); ++k) {
+        const ua::AnswerSpan chunk{m_pAns->getChunk(k)};
+        const int base = k * ua::UserAnswer::CHUNK_SIZE;
+        for(int j = 0; j < chunk.size; ++j)
+            m_nav.setEmpty(base + j, chunk.data[j] == ua::ANSWER_NODATA);
+    }
 }
 
-void KkrBoard::renderAnswer(QPoint /*cellPos*/)
+void KkrBoard::renderAnswer(QPoint cellPos)
 {
-    update();
+    m_nav.setEmpty(cellPos.x() + cellPos.y() * m_pData->getNumCols(),
+                   m_pAns->getAnswer(cellPos.x(), cellPos.y()) == ua::ANSWER_NODATA);
+    updateCell(cellPos.x(), cellPos.y());
+}
+
+void KkrBoard::updateMistakes(const std::vector<int> &wrongCells)
+{
+    // many small rects make the update region expensive; repaint all instead
+    static const int MAX_CELL_UPDATES = 64;
+    const bool updateAll = m_mistakeCells.size() + wrongCells.size() > MAX_CELL_UPDATES;
+    const int numCols = m_pData->getNumCols();
+
+    for(const int i : m_mistakeCells) {
+        m_mistakes[i] = 0;
+        if(!updateAll)
+            updateCell(i % numCols, i / numCols);
+    }
+    m_mistakeCells = wrongCells;
+    for(const int i : m_mistakeCells) {
+        m_mistakes[i] = 1;
+        if(!updateAll)
+            updateCell(i % numCols, i / numCols);
+    }
+
+    if(updateAll)
+        viewport()->update();
+}
+
+void KkrBoard::clearMistake(QPoint cellPos)
+{
+    const int i = cellPos.x() + cellPos.y() * m_pData->getNumCols();
+    if(m_mistakes[i] != 0) {
+        m_mistakes[i] = 0;
+        updateCell(cellPos.x(), cellPos.y());
+    }
 }
 
 void KkrBoard::cellInput(int value)
@@ -90,138 +146,121 @@ void KkrBoard::cellInput(int value)
     emit newAnswerInput(cd);
 }
 
-/*
- * regular methods
- */
-void KkrBoard::setScrollArea(QScrollArea *pScrollArea)
+void KkrBoard::zoomIn()
 {
-    m_pScrollArea = pScrollArea;
+    setZoomLevel(m_zoomLevel + 1, viewport()->rect().center());
 }
 
-QRect KkrBoard::getCellRect(int col, int row) const
+void KkrBoard::zoomOut()
 {
-    const int x = MARGIN + FRAME_THICK + col * (CELL_WIDTH + BORDER_THICK);
-    const int y = MARGIN + FRAME_THICK + row * (CELL_WIDTH + BORDER_THICK);
-    return QRect(x, y, CELL_WIDTH, CELL_WIDTH);
+    setZoomLevel(m_zoomLevel - 1, viewport()->rect().center());
 }
 
-QRect KkrBoard::getClueRectRight(const QRect &cellRect) const
+void KkrBoard::zoomReset()
 {
-    const QPoint topRight{cellRect.topRight()};
-    const int x = topRight.x() - CLUE_WIDTH - 1;
-    const int y = topRight.y() + 2;
-    return QRect(x, y, CLUE_WIDTH, CLUE_WIDTH);
+    setZoomLevel(DEFAULT_ZOOM_LEVEL, viewport()->rect().center());
 }
 
-QRect KkrBoard::getClueRectDown(const QRect &cellRect) const
+/*
+ * regular methods
+ */
+QRect KkrBoard::boardToScaled(const QRect &rect) const
 {
-    const QPoint bottomLeft{cellRect.bottomLeft()};
-    const int x = bottomLeft.x() + 2;
-    const int y = bottomLeft.y() - CLUE_WIDTH - 1;
-    return QRect(x, y, CLUE_WIDTH, CLUE_WIDTH);
+    const qreal z = zoom();
+    return QRectF(QPointF(rect.topLeft()) * z, QSizeF(rect.size()) * z).toAlignedRect();
 }
 
-QPoint KkrBoard::getCellCoord(int x, int y) const
+QRect KkrBoard::scaledToBoard(const QRect &rect) const
 {
-    QPoint ret(-1, -1);
-    static const int ORIGIN = MARGIN + FRAME_THICK;
-    static const int CELL_FRAME_WIDTH = CELL_WIDTH + BORDER_THICK;
+    const qreal z = zoom();
+    return QRectF(QPointF(rect.topLeft()) / z, QSizeF(rect.size()) / z).toAlignedRect();
+}
 
-    x -= ORIGIN; y -= ORIGIN;
-    if(x < 0 || y < 0)
-        return ret;
+void KkrBoard::drawAnswerCell(QPainter &p, int col, int row) const
+{
+    if(!m_showDigits)
+        return;
 
-    if(x % CELL_FRAME_WIDTH == CELL_WIDTH || y % CELL_FRAME_WIDTH == CELL_WIDTH)
-        return ret; // on the cell border
+    const QRect cellRect{getCellRect(col, row)};
+    if(m_curCol == col && m_curRow == row)
+        p.fillRect(cellRect, m_renderer.getBrush(BoardPainter::Fill::Cursor));
+    else if(m_mistakes[col + row * m_pData->getNumCols()] != 0)
+        p.fillRect(cellRect, m_renderer.getBrush(BoardPainter::Fill::Mistake));
+    const int ans = m_pAns->getAnswer(col, row);
+    if(ans != ua::ANSWER_NODATA) {
+        m_renderer.drawAnswer(p, col, row, ans);
+    }
+}
 
-    const int col = x / CELL_FRAME_WIDTH;
-    const int row = y / CELL_FRAME_WIDTH;
-    if(col >= m_pData->getNumCols() || row >= m_pData->getNumRows())
-        return ret;
+void KkrBoard::drawAnswerCellLod(QPainter &p, int col, int row) const
+{
+    if(!m_showDigits)
+        return;
+
+    const QRect cellRect{getCellRect(col, row)};
+    if(m_curCol == col && m_curRow == row)
+        p.fillRect(cellRect, m_renderer.getBrush(BoardPainter::Fill::Cursor));
+    else if(m_mistakes[col + row * m_pData->getNumCols()] != 0)
+        p.fillRect(cellRect, m_renderer.getBrush(BoardPainter::Fill::Mistake));
+}
 
-    ret.setX(col); ret.setY(row);
+void KkrBoard::updateScrollBars()
+{
+    const QSize vp{viewport()->size()};
+    const QSize board{boardToScaled(QRect(0, 0, m_board_width, m_board_height)).size()};
+    const int step = std::max(1, qRound((CELL_WIDTH + BORDER_THICK) * zoom()));
+    horizontalScrollBar()->setRange(0, std::max(0, board.width() - vp.width()));
+    horizontalScrollBar()->setPageStep(vp.width());
+    horizontalScrollBar()->setSingleStep(step);
+    verticalScrollBar()->setRange(0, std::max(0, board.height() - vp.height()));
+    verticalScrollBar()->setPageStep(vp.height());
+    verticalScrollBar()->setSingleStep(step);
+}
 
-    return ret;
+void KkrBoard::ensureVisible(int x, int y, int xmargin, int ymargin)
+{
+    // scroll bars clamp the values
+    const QPoint offset{getOffset()};
+    const QSize vp{viewport()->size()};
+    const qreal z = zoom();
+    x = qRound(x * z); y = qRound(y * z);
+    xmargin = qRound(xmargin * z); ymargin = qRound(ymargin * z);
+
+    if(x - xmargin < offset.x())
+        horizontalScrollBar()->setValue(x - xmargin);
+    else if(x > offset.x() + vp.width() - xmargin)
+        horizontalScrollBar()->setValue(x - vp.width() + xmargin);
+
+    if(y - ymargin < offset.y())
+        verticalScrollBar()->setValue(y - ymargin);
+    else if(y > offset.y() + vp.height() - ymargin)
+        verticalScrollBar()->setValue(y - vp.height() + ymargin);
 }
 
-void KkrBoard::drawCell(QPainter &p, int col, int row) const
+void KkrBoard::setZoomLevel(int level, const QPoint &anchor)
 {
-    static const char * digits[] = {
-        "0",  "1",  "2",  "3",  "4",  "5",  "6",  "7",  "8",  "9",
-        "10", "11", "12", "13", "14", "15", "16", "17", "18", "19",
-        "20", "21", "22", "23", "24", "25", "26", "27", "28", "29",
-        "30", "31", "32", "33", "34", "35", "36", "37", "38", "39",
-        "40", "41", "42", "43", "44", "45"
-    };
-    const QRect cellRect{getCellRect(col, row)};
-    switch(m_pData->getCellType(col, row)) {
-    case pd::CellType::CellAnswer:
-        if(m_showDigits) {
-            if(m_curCol == col && m_curRow == row) {
-                QBrush brCyan(Qt::cyan);
-                p.fillRect(cellRect, brCyan);
-            }
-            const int ans = m_pAns->getAnswer(col, row);
-            if(ans != ua::ANSWER_NODATA) {
-                p.setFont(m_fontAns);
-                p.drawText(cellRect, Qt::AlignCenter | Qt::AlignHCenter, digits[ans]);
-            }
-        }
-        break;
-    case pd::CellType::CellClue:
-    {
-        QBrush brFG{ m_curCol==col && m_curRow==row ? Qt::cyan : Qt::black };
-        p.setBrush(brFG);
-        std::array<QPoint, 3> points;
-
-        // upper right triangle
-        points[0] = cellRect.topLeft(); points[0] += QPoint(2,1);
-        points[1] = cellRect.topRight(); points[1] += QPoint(-1,1);
-        points[2] = cellRect.bottomRight(); points[2] += QPoint(-1,-2);
-        p.drawPolygon(points.data(), static_cast<int>(points.size()));
-
-        // bottom left triangle
-        points[0] = cellRect.topLeft(); points[0] += QPoint(1,2);
-        points[1] = cellRect.bottomLeft(); points[1] += QPoint(1,-1);
-        points[2] = cellRect.bottomRight(); points[2] += QPoint(-2,-1);
-        p.drawPolygon(points.data(), static_cast<int>(points.size()));
-
-        QBrush brWhite(Qt::white);
-        if(m_pData->getClueRight(col, row) != pd::CLOSED_CLUE) {
-            const QRect clueRect{getClueRectRight(cellRect)};
-            p.fillRect(clueRect, brWhite);
-            if(m_showDigits) {
-                 p.setFont(m_fontClue);
-                 p.drawText(clueRect, Qt::AlignCenter | Qt::AlignHCenter,
-                            digits[m_pData->getClueRight(col, row)]);
-            }
-        }
+    level = qBound(0, level, NUM_ZOOM_LEVELS - 1);
+    if(level == m_zoomLevel)
+        return;
 
-        if(m_pData->getClueDown(col, row) != pd::CLOSED_CLUE) {
-            const QRect clueRect{getClueRectDown(cellRect)};
-            p.fillRect(clueRect, brWhite);
-            if(m_showDigits) {
-                 p.setFont(m_fontClue);
-                 p.drawText(clueRect, Qt::AlignCenter | Qt::AlignHCenter,
-                            digits[m_pData->getClueDown(col, row)]);
-            }
-        }
-    }
-        break;
-    default:
-        Q_ASSERT(false);
-    }
+    const QPointF boardPos{QPointF(anchor + getOffset()) / zoom()};
+    m_zoomLevel = level;
+    updateScrollBars();
+    const QPointF scaledPos{boardPos * zoom() - QPointF(anchor)};
+    horizontalScrollBar()->setValue(qRound(scaledPos.x()));
+    verticalScrollBar()->setValue(qRound(scaledPos.y()));
+
+    m_pCellInput->setVisible(false);
+    viewport()->update();
+    emit zoomChanged(zoom());
 }
 
 void KkrBoard::showCell(int col, int row)
 {
-    if(m_pScrollArea != nullptr) {
-        m_scrCol = col; m_scrRow = row;
-        const QRect cellRect = getCellRect(col, row);
-        // the top/right clue cell must be also in the visible area
-        m_pScrollArea->ensureVisible(cellRect.x(), cellRect.y(),
-                                     FRAME_THICK+CELL_WIDTH, FRAME_THICK+CELL_WIDTH);
-    }
+    const QRect cellRect = getCellRect(col, row);
+    // the top/right clue cell must be also in the visible area
+    ensureVisible(cellRect.x(), cellRect.y(),
+                  FRAME_THICK+CELL_WIDTH, FRAME_THICK+CELL_WIDTH);
 }
 
 void KkrBoard::resetCursor(int newCol, int newRow)
@@ -233,44 +272,128 @@ void KkrBoard::resetCursor(int newCol, int newRow)
     // make sure the cursor comes in the visible area
     showCell(newCol, newRow);
 
+    // only the old and new cursor cells change
+    updateCell(m_curCol, m_curRow);
     m_curCol = newCol; m_curRow = newRow;
-    update(); // can be optimized
+    updateCell(m_curCol, m_curRow);
 }
 
-void KkrBoard::paintEvent(QPaintEvent *)
+void KkrBoard::paintEvent(QPaintEvent *e)
 {
-    QPainter p(this);
+    if(m_pData == nullptr)
+        return;
+
+    QPainter p(viewport());
+    const QPoint offset{getOffset()};
+    p.translate(-offset);
 
-    // frame
-    p.fillRect(MARGIN, MARGIN, m_frame_width, FRAME_THICK, Qt::SolidPattern);
-    p.fillRect(MARGIN, MARGIN+m_frame_height-FRAME_THICK, m_frame_width, FRAME_THICK, Qt::SolidPattern);
-    p.fillRect(MARGIN, MARGIN, FRAME_THICK, m_frame_height, Qt::SolidPattern);
-    p.fillRect(MARGIN+m_frame_width-FRAME_THICK, MARGIN, FRAME_THICK, m_frame_height, Qt::SolidPattern);
+    // the region is usually a few cells, e.g. the old and new cursor,
+    // or the strip uncovered by scrolling
+    // painting its bounding rect could cover the whole viewport
+    for(const QRect &exposed : e->region().rects())
+        paintArea(p, exposed.translated(offset));
+}
 
-    // cell borders
-    const int TL = MARGIN + FRAME_THICK;
-    for(int yi = 1; yi < m_pData->getNumRows(); ++yi) {
-        const int y = TL - BORDER_THICK + yi * (BORDER_THICK+CELL_WIDTH);
-        p.fillRect(TL, y, m_inner_width, BORDER_THICK, Qt::SolidPattern);
+void KkrBoard::invalidateStaticLayer()
+{
+    if(m_pData == nullptr)
+        return;
+    for(int level = 0; level < NUM_ZOOM_LEVELS; ++level) {
+        const qreal z = ZOOM_LEVELS[level];
+        TileGrid &grid = m_pyramid[level];
+        grid.cols = (qCeil(m_board_width * z) + TILE_SIZE - 1) / TILE_SIZE;
+        grid.rows = (qCeil(m_board_height * z) + TILE_SIZE - 1) / TILE_SIZE;
+        grid.tiles.clear();
     }
+    m_tileLru.clear();
+}
 
-    for(int xi = 1; xi < m_pData->getNumCols(); ++xi) {
-        const int x = TL - BORDER_THICK + xi * (BORDER_THICK+CELL_WIDTH);
-        p.fillRect(x, TL, BORDER_THICK, m_inner_height, Qt::SolidPattern);
+const QPixmap &KkrBoard::staticTile(int tileCol, int tileRow) const
+{
+    TileGrid &grid = m_pyramid[m_zoomLevel];
+    if(grid.tiles.empty())
+        grid.tiles.resize(grid.cols * grid.rows);
+    const int index = tileCol + tileRow * grid.cols;
+    QPixmap &tile = grid.tiles[index];
+    const qreal dpr = devicePixelRatioF();
+
+    const std::pair<int, int> key{m_zoomLevel, index};
+    const auto lru = std::find(m_tileLru.begin(), m_tileLru.end(), key);
+    if(lru != m_tileLru.end()) {
+        m_tileLru.erase(lru);
+        m_tileLru.push_back(key);
+        if(tile.devicePixelRatio() == dpr)
+            return tile;
+    } else {
+        if(static_cast<int>(m_tileLru.size()) >= MAX_TILES) {
+            const auto &oldest = m_tileLru.front();
+            m_pyramid[oldest.first].tiles[oldest.second] = QPixmap();
+            m_tileLru.erase(m_tileLru.begin());
+        }
+        m_tileLru.push_back(key);
     }
 
-    // cell contents
-    for(int y = 0; y < m_pData->getNumRows(); ++y) {
-        for(int x = 0; x < m_pData->getNumCols(); ++x) {
-            drawCell(p, x, y);
+    // rendered at the device resolution so that blitting does not scale
+    const QRect tileRect{tileCol * TILE_SIZE, tileRow * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+    tile = QPixmap(tileRect.size() * dpr);
+    tile.setDevicePixelRatio(dpr);
+    tile.fill(viewport()->palette().color(viewport()->backgroundRole()));
+
+    QPainter p(&tile);
+    p.translate(-tileRect.topLeft());
+    p.scale(zoom(), zoom());
+    if(isDetailed())
+        m_renderer.paintStatic(p, *m_pData, scaledToBoard(tileRect), m_showDigits);
+    else
+        m_renderer.paintStaticLod(p, *m_pData, scaledToBoard(tileRect), m_zoomLevel >= GRID_ZOOM_LEVEL);
+    return tile;
+}
+
+void KkrBoard::paintArea(QPainter &p, const QRect &exposed) const
+{
+    // static layer
+    const qreal dpr = devicePixelRatioF();
+    const TileGrid &grid = m_pyramid[m_zoomLevel];
+    const int lastTileCol = std::min(exposed.right() / TILE_SIZE, grid.cols - 1);
+    const int lastTileRow = std::min(exposed.bottom() / TILE_SIZE, grid.rows - 1);
+    for(int ty = std::max(exposed.top(), 0) / TILE_SIZE; ty <= lastTileRow; ++ty) {
+        for(int tx = std::max(exposed.left(), 0) / TILE_SIZE; tx <= lastTileCol; ++tx) {
+            const QPoint origin{tx * TILE_SIZE, ty * TILE_SIZE};
+            const QRect target{exposed & QRect(origin, QSize(TILE_SIZE, TILE_SIZE))};
+            const QRectF source{QPointF(target.topLeft() - origin) * dpr, QSizeF(target.size()) * dpr};
+            p.drawPixmap(QRectF(target), staticTile(tx, ty), source);
         }
     }
+
+    // dynamic layer: cursor, mistakes and answers
+    const QRect range{getCellRange(scaledToBoard(exposed))};
+    if(range.isEmpty())
+        return;
+
+    p.save();
+    p.scale(zoom(), zoom());
+    if(isDetailed()) {
+        for(int y = range.top(); y <= range.bottom(); ++y)
+            for(int x = range.left(); x <= range.right(); ++x)
+                if(m_pData->getCellType(x, y) == pd::CellType::CellAnswer)
+                    drawAnswerCell(p, x, y);
+    } else {
+        // only the marked cells; the cost does not depend on the visible cell count
+        const int numCols = m_pData->getNumCols();
+        for(const int i : m_mistakeCells)
+            if(range.contains(i % numCols, i / numCols))
+                drawAnswerCellLod(p, i % numCols, i / numCols);
+        if(range.contains(m_curCol, m_curRow))
+            drawAnswerCellLod(p, m_curCol, m_curRow);
+    }
+    p.restore();
 }
 
 void KkrBoard::mousePressEvent(QMouseEvent *e)
 {
     if(m_acceptInput && e->button() == Qt::RightButton) {
-        const QPoint pt = getCellCoord(e->x(), e->y());
+        const QPointF boardPos{QPointF(e->pos() + getOffset()) / zoom()};
+        const QPoint pt = getCellCoord(qFloor(boardPos.x()), qFloor(boardPos.y()));
         if(pt.x() >= 0 && m_pData->getCellType(pt.x(), pt.y()) == pd::CellType::CellAnswer) {
             m_inCol = pt.x(); m_inRow = pt.y();
             m_inValue = m_pAns->getAnswer(pt.x(), pt.y());
@@ -279,107 +402,97 @@ void KkrBoard::mousePressEvent(QMouseEvent *e)
 
             // invoke mouse input widget
             const QRect cellRect = getCellRect(pt);
-            m_pCellInput->move(cellRect.x(), cellRect.y());
+            m_pCellInput->move(viewport()->pos() + boardToScaled(cellRect).topLeft() - getOffset());
+            m_pCellInput->raise();
             m_pCellInput->setEnabled(true);
             m_pCellInput->setVisible(true);
         }
     }
 }
 
+void KkrBoard::moveCursor(int cell)
+{
+    if(cell == NavigationTable::NO_CELL)
+        return;
+    const int numCols = m_pData->getNumCols();
+    if(cell != m_curCol + m_curRow * numCols)
+        resetCursor(cell % numCols, cell / numCols);
+}
+
 void KkrBoard::keyCursor(QKeyEvent *e)
 {
-    int newCol;
-    int newRow;
+    using Dir = NavigationTable::Direction;
+    Dir dir;
+    switch(e->key()) {
+    case Qt::Key_Up: case Qt::Key_K:
+        dir = Dir::Up;
+        break;
+    case Qt::Key_Down: case Qt::Key_J:
+        dir = Dir::Down;
+        break;
+    case Qt::Key_Left: case Qt::Key_H:
+        dir = Dir::Left;
+        break;
+    case Qt::Key_Right: case Qt::Key_L:
+        dir = Dir::Right;
+        break;
+    default:
+        return;
+    }
 
+    const int cell = m_curCol + m_curRow * m_pData->getNumCols();
     const auto mod = e->modifiers();
 
     if(mod == Qt::ControlModifier) {
-        switch(e->key()) {
-        case Qt::Key_Up:
-            // find the first answer cell from top
-            newCol = m_curCol;
-            for(newRow = 1;
-                m_pData->getCellType(newCol, newRow) != pd::CellType::CellAnswer;
-                ++newRow)
-                ;
-            if(newRow == m_curRow)
-                return;
-            showCell(newCol, 1);
-            break;
-
-        case Qt::Key_Down:
-            newCol = m_curCol;
-            for(newRow = m_pData->getNumRows()-1;
-                m_pData->getCellType(newCol, newRow) != pd::CellType::CellAnswer;
-                --newRow)
-                ;
-            if(newRow == m_curRow)
-                return;
-            showCell(newCol, m_pData->getNumRows()-1);
-            break;
-
-        case Qt::Key_Left:
-            newRow = m_curRow;
-            for(newCol = 1;
-                m_pData->getCellType(newCol, newRow) != pd::CellType::CellAnswer;
-                ++newCol)
-                ;
-            if(newCol == m_curCol)
-                return;
-            showCell(1, newRow);
-            break;
-
-        case Qt::Key_Right:
-            newRow = m_curRow;
-            for(newCol = m_pData->getNumCols()-1;
-                m_pData->getCellType(newCol, newRow) != pd::CellType::CellAnswer;
-                --newCol)
-                ;
-            if(newCol == m_curCol)
-                return;
-            showCell(m_pData->getNumCols()-1, newRow);
-            break;
-
-        default:
+        // arrow keys only; the first or last answer cell of the column or row
+        if(e->key() != Qt::Key_Up && e->key() != Qt::Key_Down
+                && e->key() != Qt::Key_Left && e->key() != Qt::Key_Right)
+            return;
+        const int newCell = m_nav.edge(cell, dir);
+        if(newCell == NavigationTable::NO_CELL || newCell == cell)
             return;
-        }
 
-    } else if(mod == Qt::NoModifier) {
-        switch(e->key()) {
-        case Qt::Key_Up: case Qt::Key_K:
-            if(m_curRow <= 1)
-                return;
-            newCol = m_curCol;
-            newRow = m_curRow - 1;
+        // bring the end of the board into view as well
+        switch(dir) {
+        case Dir::Up:
+            showCell(m_curCol, 1);
             break;
-
-        case Qt::Key_Down: case Qt::Key_J:
-            if(m_curRow >= m_pData->getNumRows()-1)
-                return;
-            newCol = m_curCol;
-            newRow = m_curRow + 1;
+        case Dir::Down:
+            showCell(m_curCol, m_pData->getNumRows()-1);
             break;
-
-        case Qt::Key_Left: case Qt::Key_H:
-            if(m_curCol <= 1)
-                return;
-            newCol = m_curCol - 1;
-            newRow = m_curRow;
+        case Dir::Left:
+            showCell(1, m_curRow);
             break;
-
-        case Qt::Key_Right: case Qt::Key_L:
-            if(m_curCol >= m_pData->getNumCols()-1)
-                return;
-            newCol = m_curCol + 1;
-            newRow = m_curRow;
+        case Dir::Right:
+            showCell(m_pData->getNumCols()-1, m_curRow);
             break;
-
-        default:
-            return;
         }
+        moveCursor(newCell);
+    } else if(mod == Qt::NoModifier) {
+        moveCursor(m_nav.step(cell, dir));
     }
+}
+
+void KkrBoard::keyJump(QKeyEvent *e)
+{
+    if(e->modifiers() != Qt::NoModifier)
+        return;
 
-    resetCursor(newCol, newRow);
+    const int cell = m_curCol + m_curRow * m_pData->getNumCols();
+    switch(e->key()) {
+    case Qt::Key_W:
+        moveCursor(m_nav.nextRun(cell));
+        break;
+    case Qt::Key_B:
+        moveCursor(m_nav.prevRun(cell));
+        break;
+    case Qt::Key_N:
+        moveCursor(m_nav.nextEmpty(cell));
+        break;
+    case Qt::Key_P:
+        moveCursor(m_nav.prevEmpty(cell));
+        break;
+    }
 }
 
 void KkrBoard::keyData(QKeyEvent *e)
@@ -436,6 +549,27 @@ void KkrBoard::keyData(QKeyEvent *e)
     emit newAnswerInput(newData);
 }
 
+void KkrBoard::wheelEvent(QWheelEvent *e)
+{
+    if(e->modifiers() != Qt::ControlModifier) {
+        QAbstractScrollArea::wheelEvent(e);
+        return;
+    }
+
+    // zoom around the mouse pointer
+    if(e->angleDelta().y() > 0)
+        setZoomLevel(m_zoomLevel + 1, e->pos());
+    else if(e->angleDelta().y() < 0)
+        setZoomLevel(m_zoomLevel - 1, e->pos());
+    e->accept();
+}
+
+void KkrBoard::keyPressEvent(QKeyEvent *e)
+{
+    // keys are handled on release; don't let the scroll area scroll with them
+    e->accept();
+}
+
 void KkrBoard::keyReleaseEvent(QKeyEvent *e)
 {
     if(!m_acceptInput)
@@ -449,6 +583,11 @@ void KkrBoard::keyReleaseEvent(QKeyEvent *e)
         keyCursor(e);
         break;
 
+    case Qt::Key_W: case Qt::Key_B:     // runs
+    case Qt::Key_N: case Qt::Key_P:     // empty cells
+        keyJump(e);
+        break;
+
     case Qt::Key_Space: case Qt::Key_Delete: case Qt::Key_0: // delete answer
     case Qt::Key_1: case Qt::Key_2: case Qt::Key_3:
     case Qt::Key_4: case Qt::Key_5: case Qt::Key_6:
@@ -457,3 +596,14 @@ void KkrBoard::keyReleaseEvent(QKeyEvent *e)
         break;
     }
 }
+
+void KkrBoard::resizeEvent(QResizeEvent *)
+{
+    updateScrollBars();
+}
+
+void KkrBoard::scrollContentsBy(int dx, int dy)
+{
+    // reuse the pixels on the screen; only the uncovered strip is painted
+    viewport()->scroll(dx, dy);
+}
@@ -1,43 +1,79 @@
 #ifndef KKRBOARD_H
 #define KKRBOARD_H
 
-#include <QWidget>
-#include <QFont>
+#include <QAbstractScrollArea>
+#include <QScrollBar>
+#include <QPixmap>
 #include <QPoint>
 #include <QMouseEvent>
-#include <QScrollArea>
+#include <QWheelEvent>
 #include "cosmetic.h"
+#include "boardrenderer.h"
+#include "navigationtable.h"
 #include "problemdata.h"
 #include "playstatus.h"
 #include "useranswermanager.h"
 #include <memory>
+#include <vector>
+#include <utility>
+#include <cstdint>
 
 namespace pd = problemdata;
 namespace ua = useranswer;
 
-class KkrBoard : public QWidget
+/*
+ * Board view
+ * The board is not a child widget of a scroll area; it is painted directly on
+ * the viewport, translated by the scroll position, so only the visible cells
+ * are ever computed regardless of the board size.
+ * Below DETAIL_ZOOM_LEVEL the board is drawn in less detail: cell types only,
+ * no borders at the smallest scales and no digits.
+ */
+class KkrBoard : public QAbstractScrollArea
 {
     Q_OBJECT
     // dimensions
-    int m_inner_width;
-    int m_inner_height;
-    int m_frame_width;
-    int m_frame_height;
     int m_board_width;
     int m_board_height;
 
-    // fonts for digits
-    QFont m_fontAns;
-    QFont m_fontClue;
+    BoardRenderer m_renderer;
 
     // UI flags
     bool m_showDigits;
     bool m_acceptInput;
 
+    // zoom
+    static const int NUM_ZOOM_LEVELS = 8;
+    static const qreal ZOOM_LEVELS[NUM_ZOOM_LEVELS];
+    static const int DEFAULT_ZOOM_LEVEL = 5;    // 1.0
+    static const int DETAIL_ZOOM_LEVEL = 3;     // 0.5
+    static const int GRID_ZOOM_LEVEL = 2;       // 0.25
+    int m_zoomLevel;
+    qreal zoom() const {return ZOOM_LEVELS[m_zoomLevel];}
+    bool isDetailed() const {return m_zoomLevel >= DETAIL_ZOOM_LEVEL;}
+
+    // static layer: frame, borders and clue cells rendered in tiles
+    // one tile grid per zoom level, each built on demand
+    // cleared when the problem or clue digit visibility changes
+    static const int TILE_SIZE = 512;       // in scaled coord
+    static const int MAX_TILES = 48;
+        // least recently used tiles of any level are dropped beyond this
+    struct TileGrid {
+        int cols;
+        int rows;
+        std::vector<QPixmap> tiles;     // allocated when the level is first shown
+    };
+    mutable std::vector<TileGrid> m_pyramid;                // indexed by zoom level
+    mutable std::vector<std::pair<int, int>> m_tileLru;     // (level, index), least recent first
+
     // data
     std::shared_ptr<pd::ProblemData> m_pData;
     ua::SharedAnswer m_pAns;
 
+    // cells marked as wrong answers
+    std::vector<std::uint8_t> m_mistakes;   // per cell flag
+    std::vector<int> m_mistakeCells;         // indexes of flagged cells
+
     // user input sub window
     int m_inCol;
     int m_inRow;
@@ -47,66 +83,102 @@ class KkrBoard : public QWidget
     // input cursor
     int m_curCol;
     int m_curRow;
-    // scroll cell position
-    int m_scrCol;
-    int m_scrRow;
-
-    // for auto scroll
-    QScrollArea *m_pScrollArea;
+    NavigationTable m_nav;
 
     /*
      * coord conversion
+     * board coord is the pixel position on the whole board at zoom 1.0
+     * scaled coord = board coord * zoom()
+     * viewport coord = scaled coord - getOffset()
      */
+    QPoint getOffset() const {return QPoint(horizontalScrollBar()->value(), verticalScrollBar()->value());}
+    QRect boardToScaled(const QRect &rect) const;
+    QRect scaledToBoard(const QRect &rect) const;
+        // both return the smallest rect covering every pixel touched by rect
 
-    // cell coord -> widget coord
-    QRect getCellRect(int col, int row) const;
+    // cell coord -> board coord
+    QRect getCellRect(int col, int row) const {return BoardRenderer::getCellRect(col, row);}
     QRect getCellRect(const QPoint &pt) const {return getCellRect(pt.x(), pt.y());}
-    QRect getClueRectRight(const QRect &cellRect) const;
-    QRect getClueRectDown(const QRect &cellRect) const;
 
-    // widget coord -> cell coord
-    QPoint getCellCoord(int x, int y) const;
-        // if widget coord is not on a cell, returns (-1, -1)
+    // board coord -> cell coord
+    QPoint getCellCoord(int x, int y) const {return BoardRenderer::getCellCoord(*m_pData, x, y);}
+        // if board coord is not on a cell, returns (-1, -1)
+    QRect getCellRange(const QRect &rect) const {return BoardRenderer::getCellRange(*m_pData, rect);}
 
     /*
      * paint sub methods
      */
-    void drawCell(QPainter &p, int col, int row) const;
+    void invalidateStaticLayer();
+    const QPixmap &staticTile(int tileCol, int tileRow) const;
+    void paintArea(QPainter &p, const QRect &exposed) const;
+        // blit the static layer, then draw answer cells on top; exposed in scaled coord
+    void drawAnswerCell(QPainter &p, int col, int row) const;
+    void drawAnswerCellLod(QPainter &p, int col, int row) const;
+        // cursor and mistake marks only
+    void updateBoardRect(const QRect &rect) {viewport()->update(boardToScaled(rect).translated(-getOffset()));}
+    void updateCell(int col, int row) {updateBoardRect(getCellRect(col, row));}
+        // schedule a repaint of a single cell
+
+    /*
+     * scroll
+     */
+    void updateScrollBars();
+    void ensureVisible(int x, int y, int xmargin, int ymargin);
+        // same as QScrollArea::ensureVisible() in board coord
+    void setZoomLevel(int level, const QPoint &anchor);
+        // keeps the board point under anchor (viewport coord) in place
     void showCell(int col, int row);
     void resetCursor(int newCol, int newRow);
+    void moveCursor(int cell);
+        // cell index as in NavigationTable; NO_CELL and the current cell are ignored
 
     /*
      * key inputs
      */
     void keyCursor(QKeyEvent *e);
+    void keyJump(QKeyEvent *e);
+        // runs and empty cells
     void keyData(QKeyEvent *e);
 
 public:
     explicit KkrBoard(QWidget *parent = 0);
     ~KkrBoard();
 
-    void setScrollArea(QScrollArea *pScrollArea);
     int getCurrentCellValue() const {return m_inValue;}
+    qreal getZoom() const {return zoom();}
 
 signals:
     void newAnswerInput(ua::CellData cellData);
+    void zoomChanged(qreal zoom);
 
 public slots:
     void updateProblem(std::shared_ptr<pd::ProblemData> pNewData);
     void updateStatus(playstatus::Status newStatus);
     void updateUserAnswer(ua::SharedAnswer pNewAns);
     void renderAnswer(QPoint cellPos);
+    void updateMistakes(const std::vector<int> &wrongCells);
+        // highlight the cells (indexes col + row * numCols); replaces the previous ones
+    void clearMistake(QPoint cellPos);
 
     // from cell input
     void cellInput(int value);
 
+    // zoom around the center of the viewport
+    void zoomIn();
+    void zoomOut();
+    void zoomReset();
+
 protected:
     /*
-     * QWidget overrides
+     * QAbstractScrollArea overrides
      */
     void paintEvent(QPaintEvent * e) override;
     void mousePressEvent(QMouseEvent *e) override;
+    void wheelEvent(QWheelEvent *e) override;
+    void keyPressEvent(QKeyEvent *e) override;
     void keyReleaseEvent(QKeyEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override;
+    void scrollContentsBy(int dx, int dy) override;
 };
 
 #endif // KKRBOARD_H
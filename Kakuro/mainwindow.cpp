@@ -3,12 +3,18 @@
 #include <QFontMetrics>
 #include <QWidget>
 #include <QBoxLayout>
-#include <QScrollArea>
 #include <QMenuBar>
 #include <QDockWidget>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
 #include "problemdata.h"
+#include "replaydialog.h"
+#include "boardexport.h"
 #include <QDebug>
 
 /*
@@ -66,17 +72,13 @@ void MainWindow::setupCentralPane()
     pBLCenter->addLayout(pBLButtons);
 
     // main board
-    m_pScrollKkr = new QScrollArea;
     QPalette palBack(palette());
     palBack.setColor(QPalette::Background, Qt::white);
-    m_pScrollKkr->setPalette(palBack);
-    m_pScrollKkr->setAutoFillBackground(true);
-    m_pScrollKkr->setMinimumWidth(BOARD_WIDTH);
-    m_pScrollKkr->setMinimumHeight(BOARD_HEIGHT);
-    m_pScrollKkr->setWidget(m_pKkrBoard);
-    m_pScrollKkr->installEventFilter(this);
-    pBLCenter->addWidget(m_pScrollKkr);
-    m_pKkrBoard->setScrollArea(m_pScrollKkr);
+    m_pKkrBoard->viewport()->setPalette(palBack);
+    m_pKkrBoard->viewport()->setBackgroundRole(QPalette::Background);
+    m_pKkrBoard->setMinimumWidth(BOARD_WIDTH);
+    m_pKkrBoard->setMinimumHeight(BOARD_HEIGHT);
+    pBLCenter->addWidget(m_pKkrBoard);
 
     // time indicator
     QBoxLayout *pBLTime = new QBoxLayout{QBoxLayout::LeftToRight};
@@ -94,6 +96,10 @@ void MainWindow::setupMainMenu()
     // File menu
     QMenu * pMenuFile = new QMenu{tr("&File")};
     pMenuFile->addAction(tr("&Open"), this, &MainWindow::open);
+    m_pActionReplay = pMenuFile->addAction(tr("&Replay..."), this, &MainWindow::replay);
+    m_pActionReplay->setEnabled(false);
+    m_pActionExport = pMenuFile->addAction(tr("&Export..."), this, &MainWindow::exportProblem);
+    m_pActionExport->setEnabled(false);
     pMenuFile->addSeparator();
     pMenuFile->addAction(tr("E&xit"), this, &QWidget::close);
     pMainMenu->addMenu(pMenuFile);
@@ -108,6 +114,10 @@ void MainWindow::setupMainMenu()
     m_pActionCheck = pMenuPlay->addAction(tr("Chec&k"), this, &MainWindow::checkIt);
     m_pActionCheck->setShortcutContext(Qt::ApplicationShortcut);
     m_pActionCheck->setShortcut(Qt::Key_K | Qt::ControlModifier);
+    m_pActionShowMistakes = pMenuPlay->addAction(tr("Show &Mistakes"), this, &MainWindow::showMistakes);
+    m_pActionShowMistakes->setCheckable(true);
+    m_pActionShowMistakes->setShortcutContext(Qt::ApplicationShortcut);
+    m_pActionShowMistakes->setShortcut(Qt::Key_M | Qt::ControlModifier);
     pMenuPlay->addSeparator();
     m_pActionGiveup = pMenuPlay->addAction(tr("Give &up"), this, &MainWindow::makeSureGiveup);
     m_pActionPlay->setEnabled(false);
@@ -118,6 +128,13 @@ void MainWindow::setupMainMenu()
 
     // View
     m_pMenuView = new QMenu{tr("&View")};
+    QAction *pActionZoom = m_pMenuView->addAction(tr("Zoom &In"), m_pKkrBoard, &KkrBoard::zoomIn);
+    pActionZoom->setShortcut(QKeySequence::ZoomIn);
+    pActionZoom = m_pMenuView->addAction(tr("Zoom &Out"), m_pKkrBoard, &KkrBoard::zoomOut);
+    pActionZoom->setShortcut(QKeySequence::ZoomOut);
+    pActionZoom = m_pMenuView->addAction(tr("&Actual Size"), m_pKkrBoard, &KkrBoard::zoomReset);
+    pActionZoom->setShortcut(Qt::Key_0 | Qt::ControlModifier);
+    m_pMenuView->addSeparator();
     pMainMenu->addMenu(m_pMenuView);
 
     setMenuBar(pMainMenu);
@@ -167,11 +184,15 @@ MainWindow::MainWindow(QWidget *parent)
     connect(&m_uam, &ua::UserAnswerManager::newUserAnswer, m_pKkrBoard, &KkrBoard::updateUserAnswer);
     connect(m_pKkrBoard, &KkrBoard::newAnswerInput, &m_uam, &ua::UserAnswerManager::updateCellAnswer);
     connect(&m_uam, &ua::UserAnswerManager::newCellAnswer, m_pKkrBoard, &KkrBoard::renderAnswer);
+    connect(&m_uam, &ua::UserAnswerManager::newCellAnswer, this, &MainWindow::recheck);
     connect(&m_uam, &ua::UserAnswerManager::undoable, this, &MainWindow::undoableChange);
 
     // timer
     connect(&m_secTimer, &QTimer::timeout, this, &MainWindow::timeout);
 
+    // journal timestamps
+    m_uam.setClock([this]() {return m_ps.getElapsedTime();});
+
     // default window size
     setMinimumWidth(MAIN_WIDTH);
     setMinimumHeight(MAIN_HEIGHT);
@@ -188,6 +209,34 @@ namespace ps = playstatus;
 /*
  * plain methods
  */
+QString MainWindow::dataPath(const QString &subDir, const QString &problemFile)
+{
+    // files of a problem are kept in the application data directory, named by the problem path
+    const QString dirPath{QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+                + QStringLiteral("/") + subDir};
+    QDir().mkpath(dirPath);
+    if(problemFile.isEmpty())
+        return dirPath;
+
+    const QByteArray key{QFileInfo(problemFile).absoluteFilePath().toUtf8()};
+    const QByteArray hash{QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex()};
+    return dirPath + QStringLiteral("/") + QString::fromLatin1(hash);
+}
+
+QString MainWindow::journalPath(const QString &problemFile)
+{
+    // one journal per problem file
+    return dataPath(QStringLiteral("journal"), problemFile) + QStringLiteral(".kkj");
+}
+
+QString MainWindow::recordPath(const QString &problemFile)
+{
+    // one record per finished play
+    const QString stamp{QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMddHHmmss"))};
+    return dataPath(QStringLiteral("records"), problemFile)
+            + QStringLiteral("-") + stamp + QStringLiteral(".kkj");
+}
+
 void MainWindow::setTimeIndicator(bool bNone)
 {
     static const QString sNone{tr("----:--")};
@@ -234,7 +283,7 @@ void MainWindow::showStatusMsg(const QString &statusMsg)
 
 void MainWindow::placeStatusMsg()
 {
-    QRect scrRect{m_pScrollKkr->geometry()};
+    QRect scrRect{m_pKkrBoard->geometry()};
     QSize ms{m_pFloatingMsg->size()};
     QPoint pos{scrRect.x()+(scrRect.width()-ms.width())/2,
                 scrRect.y()+(scrRect.height()-ms.height())/2};
@@ -246,21 +295,6 @@ void MainWindow::placeStatusMsg()
 /*
  * QWidget overrides
  */
-bool MainWindow::eventFilter(QObject *pWatched, QEvent *e)
-{
-    if(pWatched == m_pScrollKkr) {
-        switch(e->type()) {
-        case QEvent::KeyPress:
-        case QEvent::KeyRelease:
-            return true;
-        default:
-            break;
-        }
-    }
-
-    return false;
-}
-
 void MainWindow::closeEvent(QCloseEvent *e)
 {
     const auto st = m_ps.status();
@@ -275,9 +309,10 @@ void MainWindow::closeEvent(QCloseEvent *e)
         );
     }
 
-    if(accept)
+    if(accept) {
+        m_uam.syncJournal();
         e->accept();
-    else
+    } else
         e->ignore();
 }
 
@@ -317,7 +352,74 @@ void MainWindow::open()
         return;
     }
 
+    m_pProblem = pData;
+    m_problemFile = filename;
+    m_pActionReplay->setEnabled(true);
+    m_pActionExport->setEnabled(true);
     emit newProblem(pData);
+
+    // continue an interrupted play if its journal survived
+    qint64 lastTime;
+    if(m_uam.startJournal(journalPath(filename), &lastTime)) {
+        m_ps.restoreElapsedTime(lastTime);
+        setTimeIndicator();
+    }
+}
+
+void MainWindow::replay()
+{
+    if(m_pProblem == nullptr)
+        return;
+
+    QString filename = QFileDialog::getOpenFileName(this,
+                                                    tr("Open Kakuro Record"),
+                                                    dataPath(QStringLiteral("records"), QString()),
+                                                    "Kakuro record (*.kkj)",
+                                                    nullptr,
+                                                    QFileDialog::ReadOnly);
+    if(filename == QStringLiteral(""))
+        return;
+
+    ReplayDialog *pDlg = new ReplayDialog{m_pProblem, this};
+    pDlg->setAttribute(Qt::WA_DeleteOnClose);
+    if(!pDlg->load(filename)) {
+        delete pDlg;
+        QMessageBox::critical(this, tr("Kakuro Player"),
+                              tr("Not a record of the current problem: ") + filename);
+        return;
+    }
+    pDlg->show();
+}
+
+void MainWindow::exportProblem()
+{
+    if(m_pProblem == nullptr)
+        return;
+
+    const QString svgFilter{tr("SVG image (*.svg)")};
+    const QString pdfFilter{tr("PDF document (*.pdf)")};
+    QString selected{pdfFilter};
+    QString filename = QFileDialog::getSaveFileName(this,
+                                                    tr("Export Problem"),
+                                                    QFileInfo(m_problemFile).completeBaseName(),
+                                                    pdfFilter + ";;" + svgFilter,
+                                                    &selected);
+    if(filename == QStringLiteral(""))
+        return;
+
+    // blank puzzle; the solution is never exported from the player
+    bool ok;
+    if(selected == svgFilter) {
+        if(!filename.endsWith(".svg", Qt::CaseInsensitive))
+            filename += ".svg";
+        ok = exportSvg(*m_pProblem, filename);
+    } else {
+        if(!filename.endsWith(".pdf", Qt::CaseInsensitive))
+            filename += ".pdf";
+        ok = exportPdf(*m_pProblem, filename);
+    }
+    if(!ok)
+        QMessageBox::critical(this, tr("Kakuro Player"), tr("Failed to export ") + filename);
 }
 
 void MainWindow::updateStatus(playstatus::Status newStatus)
@@ -384,6 +486,7 @@ void MainWindow::updateStatus(playstatus::Status newStatus)
         m_pActionCheck->setEnabled(false);
         m_pActionUndo->setEnabled(false);
         m_secTimer.stop();
+        m_uam.syncJournal();
         break;
     case ps::Status::DONE:
         if(m_ps.isSolved())
@@ -400,6 +503,8 @@ void MainWindow::updateStatus(playstatus::Status newStatus)
         m_pActionUndo->setEnabled(false);
         m_secTimer.stop();
         setTimeIndicator();
+        m_pKkrBoard->updateMistakes(std::vector<int>());
+        m_uam.archiveJournal(recordPath(m_problemFile));
         break;
     }
 }
@@ -407,15 +512,44 @@ void MainWindow::updateStatus(playstatus::Status newStatus)
 void MainWindow::timeout()
 {
     setTimeIndicator();
+    // bound the moves lost on power failure to one timer interval
+    m_uam.syncJournal();
 }
 
 void MainWindow::checkIt()
 {
-    if(m_uam.isSolved()) {
+    m_uam.check(m_check);
+    if(m_check.isSolved()) {
         emit solved();
         QMessageBox::information(this, tr("Solved!"), tr("Congratulations!"));
     } else {
-        QMessageBox::warning(this, tr("Sorry"), tr("The answer is wrong"));
+        m_pKkrBoard->updateMistakes(m_check.wrong);
+        QMessageBox::warning(this, tr("Sorry"),
+                             tr("The answer is wrong\n%1 wrong answer(s), %2 empty cell(s)")
+                             .arg(static_cast<int>(m_check.wrong.size()))
+                             .arg(static_cast<int>(m_check.empty.size())));
+    }
+}
+
+void MainWindow::recheck(QPoint cellPos)
+{
+    if(m_pActionShowMistakes->isChecked()) {
+        // training mode; whole board check on every input
+        m_uam.check(m_check);
+        m_pKkrBoard->updateMistakes(m_check.wrong);
+    } else {
+        // a corrected cell is no longer marked
+        m_pKkrBoard->clearMistake(cellPos);
+    }
+}
+
+void MainWindow::showMistakes(bool bShow)
+{
+    if(bShow && m_pProblem != nullptr) {
+        m_uam.check(m_check);
+        m_pKkrBoard->updateMistakes(m_check.wrong);
+    } else {
+        m_pKkrBoard->updateMistakes(std::vector<int>());
     }
 }
 
@@ -428,6 +562,9 @@ void MainWindow::makeSureGiveup()
 
 void MainWindow::undoableChange(bool undoable)
 {
+    // outside play the status decides; INPLAY picks up isUndoable() when it starts
+    if(m_ps.status() != ps::Status::INPLAY)
+        undoable = false;
     m_pActionUndo->setEnabled(undoable);
     m_pButtonUndo->setEnabled(undoable);
 }
@@ -7,7 +7,6 @@
 #include <QLabel>
 #include <QMenu>
 #include <QTimer>
-#include <QScrollArea>
 #include <memory>
 #include "kkrboard.h"
 #include "problemdata.h"
@@ -31,7 +30,6 @@ class MainWindow : public QMainWindow
     QPushButton *m_pButtonCheck;
 
     // main board
-    QScrollArea *m_pScrollKkr;
     KkrBoard *m_pKkrBoard;
 
     // time indicator
@@ -49,6 +47,9 @@ class MainWindow : public QMainWindow
     QAction *m_pActionUndo;
     QAction *m_pActionCheck;
     QAction *m_pActionGiveup;
+    QAction *m_pActionReplay;
+    QAction *m_pActionExport;
+    QAction *m_pActionShowMistakes;
 
     QTimer m_secTimer;
 
@@ -57,6 +58,9 @@ class MainWindow : public QMainWindow
      */
     ps::PlayStatus m_ps;
     ua::UserAnswerManager m_uam;
+    std::shared_ptr<pd::ProblemData> m_pProblem;
+    QString m_problemFile;
+    ua::CheckResult m_check;
 
     /*
      * dimensions
@@ -86,22 +90,27 @@ class MainWindow : public QMainWindow
     void showStatusMsg(const QString &statusMsg);
     void placeStatusMsg();
 
+    static QString dataPath(const QString &subDir, const QString &problemFile);
+    static QString journalPath(const QString &problemFile);
+    static QString recordPath(const QString &problemFile);
+
 public:
     MainWindow(QWidget *parent = 0);
     ~MainWindow();
 
-    // to disable scrollarea's key events
-    bool eventFilter(QObject *pWatched, QEvent *e) override;
-
 protected:
     void closeEvent(QCloseEvent *e) override;
     void resizeEvent(QResizeEvent *e) override;
 
 private slots:
     void open();
+    void replay();
+    void exportProblem();
     void updateStatus(playstatus::Status newStatus);
     void timeout();
     void checkIt();
+    void recheck(QPoint cellPos);
+    void showMistakes(bool bShow);
     void makeSureGiveup();
     void undoableChange(bool undoable);
 
@@ -0,0 +1,138 @@
+#include "navigationtable.h"
+#include <QtGlobal>
+
+namespace pd = problemdata;
+
+const int NavigationTable::NO_CELL;     // bound to references by std::vector
+
+NavigationTable::NavigationTable()
+    : m_numCols(0)
+    , m_numRows(0)
+{
+}
+
+void NavigationTable::build(const pd::ProblemData &data)
+{
+    m_numCols = data.getNumCols();
+    m_numRows = data.getNumRows();
+    const int numCells = m_numCols * m_numRows;
+
+    for(auto &table : m_step)
+        table.assign(numCells, NO_CELL);
+    m_colFirst.assign(m_numCols, NO_CELL);
+    m_colLast.assign(m_numCols, NO_CELL);
+    m_rowFirst.assign(m_numRows, NO_CELL);
+    m_rowLast.assign(m_numRows, NO_CELL);
+    m_runStarts.clear();
+    m_runOf.assign(numCells, NO_CELL);
+    m_empty.clear();
+
+    // one pass in reading order gives the cells up and left of each cell,
+    // one in reverse the cells down and right
+    std::vector<int> lastInCol(m_numCols, NO_CELL);
+    for(int row = 0; row < m_numRows; ++row) {
+        int lastInRow = NO_CELL;
+        for(int col = 0; col < m_numCols; ++col) {
+            const int cell = col + row * m_numCols;
+            m_step[dirIndex(Direction::Up)][cell] = lastInCol[col];
+            m_step[dirIndex(Direction::Left)][cell] = lastInRow;
+            if(data.getCellType(col, row) != pd::CellType::CellAnswer)
+                continue;
+
+            if(lastInRow != cell - 1)
+                m_runStarts.push_back(cell);
+            m_runOf[cell] = static_cast<int>(m_runStarts.size()) - 1;
+            m_empty.insert(m_empty.end(), cell);
+
+            if(m_colFirst[col] == NO_CELL)
+                m_colFirst[col] = cell;
+            if(m_rowFirst[row] == NO_CELL)
+                m_rowFirst[row] = cell;
+            m_colLast[col] = m_rowLast[row] = cell;
+            lastInCol[col] = lastInRow = cell;
+        }
+    }
+
+    std::vector<int> nextInCol(m_numCols, NO_CELL);
+    for(int row = m_numRows - 1; row >= 0; --row) {
+        int nextInRow = NO_CELL;
+        for(int col = m_numCols - 1; col >= 0; --col) {
+            const int cell = col + row * m_numCols;
+            m_step[dirIndex(Direction::Down)][cell] = nextInCol[col];
+            m_step[dirIndex(Direction::Right)][cell] = nextInRow;
+            if(m_runOf[cell] != NO_CELL)
+                nextInCol[col] = nextInRow = cell;
+        }
+    }
+}
+
+int NavigationTable::edge(int cell, Direction d) const
+{
+    const int col = cell % m_numCols;
+    const int row = cell / m_numCols;
+    switch(d) {
+    case Direction::Up:
+        return m_colFirst[col];
+    case Direction::Down:
+        return m_colLast[col];
+    case Direction::Left:
+        return m_rowFirst[row];
+    case Direction::Right:
+        return m_rowLast[row];
+    }
+    return NO_CELL;
+}
+
+int NavigationTable::nextRun(int cell) const
+{
+    if(m_runStarts.empty())
+        return NO_CELL;
+    const int run = m_runOf[cell];
+    if(run == NO_CELL)
+        return NO_CELL;
+    return m_runStarts[(run + 1) % m_runStarts.size()];
+}
+
+int NavigationTable::prevRun(int cell) const
+{
+    if(m_runStarts.empty())
+        return NO_CELL;
+    const int run = m_runOf[cell];
+    if(run == NO_CELL)
+        return NO_CELL;
+    if(m_runStarts[run] != cell)
+        return m_runStarts[run];
+    return m_runStarts[(run + m_runStarts.size() - 1) % m_runStarts.size()];
+}
+
+void NavigationTable::setEmpty(int cell, bool empty)
+{
+    Q_ASSERT(0 <= cell && cell < static_cast<int>(m_runOf.size()));
+    if(m_runOf[cell] == NO_CELL)
+        return;
+    if(empty)
+        m_empty.insert(cell);
+    else
+        m_empty.erase(cell);
+}
+
+int NavigationTable::nextEmpty(int cell) const
+{
+    if(m_empty.empty())
+        return NO_CELL;
+    auto it = m_empty.upper_bound(cell);
+    if(it == m_empty.end())
+        it = m_empty.begin();
+    return *it == cell ? NO_CELL : *it;
+}
+
+int NavigationTable::prevEmpty(int cell) const
+{
+    if(m_empty.empty())
+        return NO_CELL;
+    auto it = m_empty.lower_bound(cell);
+    if(it == m_empty.begin())
+        it = m_empty.end();
+    --it;
+    return *it == cell ? NO_CELL : *it;
+}
@@ -0,0 +1,71 @@
+#ifndef NAVIGATIONTABLE_H
+#define NAVIGATIONTABLE_H
+
+#include <set>
+#include <vector>
+#include "problemdata.h"
+
+/*
+ * Cursor destinations, precomputed per problem
+ * Cells are indexes col + row * numCols. Moves skip clue cells, so a lookup
+ * never scans the board; only the empty cells need a log time search as
+ * they change with every answer. Every lookup returns NO_CELL when there is
+ * nowhere to go.
+ */
+class NavigationTable
+{
+public:
+    enum class Direction {
+        Up, Down, Left, Right
+    };
+    static const int NO_CELL = -1;
+
+private:
+    static const int NUM_DIRECTIONS = 4;
+
+    int m_numCols;
+    int m_numRows;
+
+    std::vector<int> m_step[NUM_DIRECTIONS];
+        // nearest answer cell in each direction, per cell
+    std::vector<int> m_colFirst;
+    std::vector<int> m_colLast;
+    std::vector<int> m_rowFirst;
+    std::vector<int> m_rowLast;
+        // first and last answer cell of each column and row
+    std::vector<int> m_runStarts;
+        // first cell of every horizontal run in reading order
+    std::vector<int> m_runOf;
+        // index to m_runStarts per cell; NO_CELL for clue cells
+    std::set<int> m_empty;
+        // answer cells without an answer
+
+    static int dirIndex(Direction d) {return static_cast<int>(d);}
+
+public:
+    NavigationTable();
+
+    void build(const problemdata::ProblemData &data);
+        // every answer cell is empty after build
+
+    int getFirstCell() const {return m_runStarts.empty() ? NO_CELL : m_runStarts.front();}
+        // the first answer cell in reading order
+
+    int step(int cell, Direction d) const {return m_step[dirIndex(d)][cell];}
+        // arrow keys
+    int edge(int cell, Direction d) const;
+        // the farthest answer cell of the column or row of cell; Ctrl + arrow keys
+
+    int nextRun(int cell) const;
+    int prevRun(int cell) const;
+        // the first cell of the next horizontal run, or of the current one if cell is
+        // not at its start; both wrap around the board
+
+    void setEmpty(int cell, bool empty);
+        // ignored for clue cells
+    int nextEmpty(int cell) const;
+    int prevEmpty(int cell) const;
+        // the nearest empty cell other than cell in reading order; wrap around the board
+};
+
+#endif // NAVIGATIONTABLE_H
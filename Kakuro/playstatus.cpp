@@ -68,4 +68,11 @@ void PlayStatus::giveup()
     done();
 }
 
+void PlayStatus::restoreElapsedTime(qint64 elapsed)
+{
+    if(m_status != Status::READY)
+        return;
+    m_timeOffset = elapsed;
+}
+
 }   // namespace playstatus
@@ -43,6 +43,8 @@ public slots:
     void playPressed();
     void solved();
     void giveup();
+    void restoreElapsedTime(qint64 elapsed);
+        // resume the clock of a recovered play; only valid before the play starts
 
 signals:
     void statusChanged(Status newStatus);
@@ -23,6 +23,7 @@ public:
     int cols;
     int rows;
     std::vector<Cell> data;
+    std::vector<std::uint8_t> solution;
 
     int cr2i(int c, int r) const {return r * cols + c;}
         // calculate index of m_data from col and row
@@ -75,6 +76,11 @@ int ProblemData::getAnswer(int col, int row) const
     return m_->data[i].ans;
 }
 
+const std::uint8_t *ProblemData::getSolution() const
+{
+    return m_->solution.data();
+}
+
 /*
  * functions for data loader
  */
@@ -284,6 +290,12 @@ ProblemData *ProblemData::problemLoader(const QString &filename)
 
     if(pInt == nullptr)
         return nullptr;
+
+    // dense copy of the answers for whole board comparison
+    pInt->solution.resize(pInt->data.size());
+    for(size_t i = 0; i < pInt->data.size(); ++i)
+        pInt->solution[i] = (pInt->data[i].type == CellType::CellAnswer ? pInt->data[i].ans : 0);
+
     return new ProblemData(std::move(pInt));
 }
 
@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <memory>
+#include <cstdint>
 
 namespace problemdata {
 
@@ -36,6 +37,9 @@ public:
         // get clue; only valid for clue cells
     int getAnswer(int col, int row) const;
         // return answer of cell; only valid for answer cells
+    const std::uint8_t *getSolution() const;
+        // answers of all cells in a row major array of getNumCols()*getNumRows() bytes
+        // clue cells are 0
 
     static ProblemData *problemLoader(const QString &filename);
         // factory method; load problem data from a file
@@ -0,0 +1,108 @@
+#include "replaydialog.h"
+#include <QBoxLayout>
+
+ReplayDialog::ReplayDialog(std::shared_ptr<problemdata::ProblemData> pData, QWidget *parent)
+    : QDialog(parent)
+    , m_pData(pData)
+{
+    // board; shown as a finished play so that it never accepts input
+    m_pKkrBoard = new KkrBoard;
+    QPalette palBack(palette());
+    palBack.setColor(QPalette::Background, Qt::white);
+    m_pKkrBoard->viewport()->setPalette(palBack);
+    m_pKkrBoard->viewport()->setBackgroundRole(QPalette::Background);
+    m_pKkrBoard->updateProblem(m_pData);
+    m_pKkrBoard->updateStatus(playstatus::Status::DONE);
+
+    // controls
+    m_pSlider = new QSlider{Qt::Horizontal};
+    m_pSlider->setMinimum(0);
+    m_pSlider->setMaximum(0);
+    m_pButtonPrev = new QPushButton{tr("<")};
+    m_pButtonPlay = new QPushButton{tr("Play")};
+    m_pButtonNext = new QPushButton{tr(">")};
+    m_pLabelMove = new QLabel;
+    m_pLabelMove->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    QBoxLayout *pBLControls = new QBoxLayout{QBoxLayout::LeftToRight};
+    pBLControls->addWidget(m_pButtonPrev);
+    pBLControls->addWidget(m_pButtonPlay);
+    pBLControls->addWidget(m_pButtonNext);
+    pBLControls->addWidget(m_pSlider, 1);
+    pBLControls->addWidget(m_pLabelMove);
+
+    QBoxLayout *pBLTop = new QBoxLayout{QBoxLayout::TopToBottom, this};
+    pBLTop->addWidget(m_pKkrBoard, 1);
+    pBLTop->addLayout(pBLControls);
+
+    connect(m_pSlider, &QSlider::valueChanged, this, &ReplayDialog::seek);
+    connect(m_pButtonPrev, &QPushButton::clicked, this, &ReplayDialog::prev);
+    connect(m_pButtonNext, &QPushButton::clicked, this, &ReplayDialog::next);
+    connect(m_pButtonPlay, &QPushButton::clicked, this, &ReplayDialog::togglePlay);
+    connect(&m_playTimer, &QTimer::timeout, this, &ReplayDialog::next);
+
+    setWindowTitle(tr("Kakuro - Replay"));
+    resize(640, 480);
+}
+
+bool ReplayDialog::load(const QString &journalFile)
+{
+    if(!m_engine.load(*m_pData, journalFile))
+        return false;
+
+    m_pKkrBoard->updateUserAnswer(m_engine.getAnswer());
+    m_pSlider->setMaximum(m_engine.getNumMoves());
+    m_pSlider->setValue(0);
+    updateLabel();
+    m_pKkrBoard->viewport()->update();
+    return true;
+}
+
+void ReplayDialog::updateLabel()
+{
+    const int pos = m_engine.getPosition();
+    const qint64 totalSec = (pos > 0 ? m_engine.getMoveTime(pos-1) : 0) / 1000;
+    m_pLabelMove->setText(QString::asprintf("%d / %d  %4d:%02d",
+                                            pos, m_engine.getNumMoves(),
+                                            static_cast<int>(totalSec / 60),
+                                            static_cast<int>(totalSec % 60)));
+}
+
+/*
+ * slots
+ */
+void ReplayDialog::seek(int position)
+{
+    if(position == m_engine.getPosition())
+        return;
+
+    m_engine.seek(position);
+    updateLabel();
+    m_pKkrBoard->viewport()->update();
+}
+
+void ReplayDialog::prev()
+{
+    m_pSlider->setValue(m_pSlider->value() - 1);
+}
+
+void ReplayDialog::next()
+{
+    if(m_pSlider->value() >= m_pSlider->maximum()) {
+        m_playTimer.stop();
+        m_pButtonPlay->setText(tr("Play"));
+        return;
+    }
+    m_pSlider->setValue(m_pSlider->value() + 1);
+}
+
+void ReplayDialog::togglePlay()
+{
+    if(m_playTimer.isActive()) {
+        m_playTimer.stop();
+        m_pButtonPlay->setText(tr("Play"));
+    } else {
+        m_playTimer.start(PLAY_INTERVAL);
+        m_pButtonPlay->setText(tr("Stop"));
+    }
+}
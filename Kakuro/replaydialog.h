@@ -0,0 +1,54 @@
+#ifndef REPLAYDIALOG_H
+#define REPLAYDIALOG_H
+
+#include <QDialog>
+#include <QSlider>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include <memory>
+#include "kkrboard.h"
+#include "replayengine.h"
+#include "problemdata.h"
+
+namespace pd = problemdata;
+namespace ua = useranswer;
+
+class ReplayDialog : public QDialog
+{
+    Q_OBJECT
+
+    // model
+    std::shared_ptr<pd::ProblemData> m_pData;
+    ua::ReplayEngine m_engine;
+
+    // widgets
+    KkrBoard *m_pKkrBoard;
+    QSlider *m_pSlider;
+    QPushButton *m_pButtonPrev;
+    QPushButton *m_pButtonPlay;
+    QPushButton *m_pButtonNext;
+    QLabel *m_pLabelMove;
+
+    // auto play
+    static const int PLAY_INTERVAL = 100;
+    QTimer m_playTimer;
+
+    void updateLabel();
+
+public:
+    explicit ReplayDialog(std::shared_ptr<pd::ProblemData> pData, QWidget *parent = 0);
+
+    ReplayDialog(const ReplayDialog&) = delete;
+    ReplayDialog &operator=(const ReplayDialog&) = delete;
+
+    bool load(const QString &journalFile);
+
+private slots:
+    void seek(int position);
+    void prev();
+    void next();
+    void togglePlay();
+};
+
+#endif // REPLAYDIALOG_H
@@ -0,0 +1,118 @@
+#include "replayengine.h"
+#include <algorithm>
+
+namespace useranswer {
+
+ReplayEngine::ReplayEngine(int interval)
+    : m_numCols(0)
+    , m_numRows(0)
+    , m_minInterval(interval)
+    , m_interval(interval)
+    , m_position(0)
+{
+    Q_ASSERT(interval > 0);
+}
+
+ReplayEngine::~ReplayEngine()
+{
+}
+
+bool ReplayEngine::load(const problemdata::ProblemData &problem, const QString &journalFile)
+{
+    if(!AnswerJournal::readJournal(journalFile, problem.getNumCols(), problem.getNumRows(), m_records))
+        return false;
+
+    return load(problem.getNumCols(), problem.getNumRows(), m_records);
+}
+
+bool ReplayEngine::load(int numCols, int numRows, const std::vector<JournalRecord> &records)
+{
+    // as readJournal checks them; the records may come from elsewhere
+    for(const auto &rec : records)
+        if(rec.col < 0 || rec.col >= numCols || rec.row < 0 || rec.row >= numRows
+                || rec.answer < ANSWER_NODATA || rec.answer > 9)
+            return false;
+
+    if(m_pAnswer == nullptr || m_numCols != numCols || m_numRows != numRows)
+        m_pAnswer.reset(new UserAnswer(numCols, numRows));
+    m_numCols = numCols;
+    m_numRows = numRows;
+
+    // moves with the previous values resolved, so that they can be applied both ways
+    // an undo record already carries the restored value; no undo stack is needed
+    m_moves.clear();
+    m_times.clear();
+    m_moves.reserve(records.size());
+    m_times.reserve(records.size());
+    m_board.assign(numCells(), ANSWER_NODATA);
+
+    Move move;
+    for(const auto &rec : records) {
+        move.index = rec.col + rec.row * numCols;
+        move.prev = m_board[move.index];
+        move.answer = static_cast<std::uint8_t>(rec.answer);
+        m_board[move.index] = move.answer;
+        m_moves.push_back(move);
+        m_times.push_back(rec.time);
+    }
+
+    // keep the checkpoints within the memory budget
+    const qint64 cells = numCells();
+    const qint64 moves = static_cast<qint64>(m_moves.size());
+    m_interval = m_minInterval;
+    if(cells > 0 && (moves / m_interval + 1) * cells > MAX_CHECKPOINT_BYTES) {
+        const qint64 maxCheckpoints = std::max<qint64>(2, MAX_CHECKPOINT_BYTES / cells);
+        m_interval = static_cast<int>(moves / (maxCheckpoints - 1) + 1);
+    }
+
+    // record checkpoints while replaying from the empty board
+    const int numCheckpoints = static_cast<int>(moves / m_interval + 1);
+    m_checkpoints.resize(numCheckpoints * cells);
+    std::fill(m_board.begin(), m_board.end(), ANSWER_NODATA);
+    std::uint8_t *pCheckpoint = m_checkpoints.data();
+    for(int i = 0; i <= moves; ++i) {
+        if(i % m_interval == 0) {
+            std::copy(m_board.begin(), m_board.end(), pCheckpoint);
+            pCheckpoint += cells;
+        }
+        if(i < moves)
+            m_board[m_moves[i].index] = m_moves[i].answer;
+    }
+
+    restoreCheckpoint(0);
+    return true;
+}
+
+void ReplayEngine::restoreCheckpoint(int k)
+{
+    m_pAnswer->assign(m_checkpoints.data() + static_cast<size_t>(k) * numCells());
+    m_position = k * m_interval;
+}
+
+QPoint ReplayEngine::getMoveCell(int move) const
+{
+    const int i = m_moves[move].index;
+    return QPoint(i % m_numCols, i / m_numCols);
+}
+
+void ReplayEngine::seek(int position)
+{
+    Q_ASSERT(0 <= position && position <= getNumMoves());
+
+    // a short step from the current position is cheaper than a checkpoint
+    if(position < m_position && m_position - position <= m_interval) {
+        while(m_position > position) {
+            --m_position;
+            m_pAnswer->setAt(m_moves[m_position].index, m_moves[m_position].prev);
+        }
+        return;
+    }
+
+    if(position < m_position || position - m_position > m_interval)
+        restoreCheckpoint(position / m_interval);
+
+    for(; m_position < position; ++m_position)
+        m_pAnswer->setAt(m_moves[m_position].index, m_moves[m_position].answer);
+}
+
+}   // namespace useranswer
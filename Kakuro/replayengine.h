@@ -0,0 +1,78 @@
+#ifndef REPLAYENGINE_H
+#define REPLAYENGINE_H
+
+#include <QPoint>
+#include <QString>
+#include <vector>
+#include "useranswermanager.h"
+#include "answerjournal.h"
+#include "problemdata.h"
+
+namespace useranswer {
+
+/*
+ * Reconstructs the user answers at any move of a recorded play
+ * A copy of the board is kept every checkpoint interval moves, so seeking
+ * applies at most one interval of moves. Buffers are reused between load()
+ * calls; one engine can process any number of sessions without reallocating.
+ */
+class ReplayEngine
+{
+    struct Move {
+        int index;              // cell index
+        std::uint8_t answer;    // value after the move
+        std::uint8_t prev;      // value before the move
+    };
+
+    int m_numCols;
+    int m_numRows;
+    int m_minInterval;
+    int m_interval;
+    int m_position;     // # of moves applied to m_pAnswer
+
+    std::vector<JournalRecord> m_records;
+    std::vector<Move> m_moves;
+    std::vector<qint64> m_times;
+    std::vector<std::uint8_t> m_checkpoints;
+        // board at move k*m_interval is at [k*cells, (k+1)*cells)
+    std::vector<std::uint8_t> m_board;
+        // work area while loading
+
+    SharedAnswer m_pAnswer;
+
+    int numCells() const {return m_numCols * m_numRows;}
+    void restoreCheckpoint(int k);
+
+public:
+    static const int DEFAULT_INTERVAL = 256;
+    static const qint64 MAX_CHECKPOINT_BYTES = 64 * 1024 * 1024;
+        // the interval is widened when checkpoints would exceed this
+
+    explicit ReplayEngine(int interval = DEFAULT_INTERVAL);
+    ~ReplayEngine();
+
+    ReplayEngine(const ReplayEngine&) = delete;
+    ReplayEngine &operator=(const ReplayEngine&) = delete;
+
+    bool load(const problemdata::ProblemData &problem, const QString &journalFile);
+        // load a move log recorded for problem; the position is reset to 0
+    bool load(int numCols, int numRows, const std::vector<JournalRecord> &records);
+        // false if a record is outside the board or not a digit; the engine is left as it was
+
+    int getNumMoves() const {return static_cast<int>(m_moves.size());}
+    int getPosition() const {return m_position;}
+    int getInterval() const {return m_interval;}
+    qint64 getMoveTime(int move) const {return m_times[move];}
+    QPoint getMoveCell(int move) const;
+        // move is 0 based; move i brings position i to i+1
+
+    void seek(int position);
+        // position is the number of moves applied; 0 <= position <= getNumMoves()
+
+    SharedAnswer getAnswer() const {return m_pAnswer;}
+        // the same object is updated in place by seek()
+};
+
+}   // namespace useranswer
+
+#endif // REPLAYENGINE_H
@@ -1,11 +1,33 @@
 #include "useranswer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 namespace useranswer {
 
+static std::shared_ptr<std::uint8_t> makeChunk(int size)
+{
+    return std::shared_ptr<std::uint8_t>(new std::uint8_t[size], std::default_delete<std::uint8_t[]>());
+}
+
 UserAnswer::UserAnswer(int numCols, int numRows)
     : m_numCols(numCols)
     , m_numRows(numRows)
-    , m_answers(numCols*numRows, ANSWER_NODATA)
+    , m_chunks((numCols*numRows + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , m_version(0)
+{
+    for(int k = 0; k < getNumChunks(); ++k) {
+        const int size = getChunkSize(k);
+        m_chunks[k] = makeChunk(size);
+        std::fill(m_chunks[k].get(), m_chunks[k].get() + size, ANSWER_NODATA);
+    }
+}
+
+UserAnswer::UserAnswer(const UserAnswer &rhs)
+    : m_numCols(rhs.m_numCols)
+    , m_numRows(rhs.m_numRows)
+    , m_chunks(rhs.m_chunks)
+    , m_version(rhs.m_version)
 {
 }
 
@@ -14,4 +36,47 @@ UserAnswer::~UserAnswer()
     // nothing to do
 }
 
+int UserAnswer::getChunkSize(int k) const
+{
+    return std::min(CHUNK_SIZE, m_numCols*m_numRows - k*CHUNK_SIZE);
+}
+
+std::uint8_t *UserAnswer::writableChunk(int k)
+{
+    Chunk &chunk = m_chunks[k];
+    if(chunk.use_count() > 1) {
+        // shared with a snapshot; copy on write
+        const int size = getChunkSize(k);
+        Chunk copy{makeChunk(size)};
+        std::memcpy(copy.get(), chunk.get(), size);
+        chunk = copy;
+    } else {
+        // the last snapshot may have just been released on another thread;
+        // its reads of the chunk must happen before our writes
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return chunk.get();
+}
+
+void UserAnswer::setAt(int i, std::uint8_t answer)
+{
+    writableChunk(i >> CHUNK_SHIFT)[i & (CHUNK_SIZE-1)] = answer;
+    ++m_version;
+}
+
+void UserAnswer::assign(const std::uint8_t *pCells)
+{
+    for(int k = 0; k < getNumChunks(); ++k)
+        std::memcpy(writableChunk(k), pCells + k*CHUNK_SIZE, getChunkSize(k));
+    ++m_version;
+}
+
+AnswerSpan UserAnswer::getChunk(int k) const
+{
+    AnswerSpan span;
+    span.data = m_chunks[k].get();
+    span.size = getChunkSize(k);
+    return span;
+}
+
 }   // namespace useranswer
@@ -2,32 +2,76 @@
 #define USERANSWER_H
 
 #include <vector>
+#include <memory>
+#include <cstdint>
 
 namespace useranswer {
 
 static const int ANSWER_NODATA = 0;
 
+// read only view of contiguous answers for bulk algorithms
+struct AnswerSpan {
+    const std::uint8_t *data;
+    int size;
+
+    const std::uint8_t *begin() const {return data;}
+    const std::uint8_t *end() const {return data + size;}
+};
+
+/*
+ * Answers are stored in fixed size chunks shared between copies
+ * A snapshot shares all chunks with the live answers; a write copies only
+ * the chunk it touches if the chunk is shared. Snapshots are immutable and
+ * can be read from any thread.
+ */
 class UserAnswer
 {
+public:
+    static const int CHUNK_SHIFT = 12;
+    static const int CHUNK_SIZE = 1 << CHUNK_SHIFT;     // cells per chunk
+
+private:
+    typedef std::shared_ptr<std::uint8_t> Chunk;
+
     const int m_numCols;
     const int m_numRows;
-    std::vector<int> m_answers;
+    std::vector<Chunk> m_chunks;
+        // one byte per cell (0-9), row major; clue cells stay ANSWER_NODATA
+    unsigned long long m_version;
+        // incremented on every write
 
     // only friend class UserAnswerManger can construct me
     UserAnswer(int numCols, int numRows);
+    UserAnswer(const UserAnswer &rhs);
+        // shares the chunks of rhs; a snapshot when made on the writing thread
     int getIndex(int col, int row) const {return col + row * m_numCols;}
+    int getChunkSize(int k) const;
+
+    // raw access by index for friends
+    std::uint8_t at(int i) const {return m_chunks[i >> CHUNK_SHIFT].get()[i & (CHUNK_SIZE-1)];}
+    std::uint8_t *writableChunk(int k);
+        // makes chunk k private to this object before a write
+    void setAt(int i, std::uint8_t answer);
+    void assign(const std::uint8_t *pCells);
+        // overwrite all cells with pCells[0 .. numCols*numRows)
 
 public:
     ~UserAnswer();
 
-    UserAnswer(const UserAnswer&) = delete;
     UserAnswer &operator=(const UserAnswer&) = delete;
 
     int getNumCols() const {return m_numCols;}
     int getNumRows() const {return m_numRows;}
-    int getAnswer(int col, int row) const {return m_answers[getIndex(col,row)];}
+    int getAnswer(int col, int row) const {return at(getIndex(col,row));}
+
+    unsigned long long getVersion() const {return m_version;}
+
+    int getNumChunks() const {return static_cast<int>(m_chunks.size());}
+    AnswerSpan getChunk(int k) const;
+        // cells [k*CHUNK_SIZE, k*CHUNK_SIZE + size); index is col + row * getNumCols()
 
     friend class UserAnswerManager;
+    friend class ReplayEngine;
 };
 
 }   // namespace useranswer
@@ -1,4 +1,8 @@
 #include "useranswermanager.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
 #include <utility>
 
 namespace useranswer {
@@ -14,20 +18,112 @@ UserAnswerManager::~UserAnswerManager()
 /*
  * regular methods
  */
-bool UserAnswerManager::isSolved() const
+void UserAnswerManager::journal(JournalOp op, const QPoint &p, int answer)
+{
+    if(m_pJournal == nullptr)
+        return;
+
+    JournalRecord rec;
+    rec.time = m_clock ? m_clock() : 0;
+    rec.col = p.x(); rec.row = p.y();
+    rec.answer = answer;
+    rec.op = op;
+    m_pJournal->append(rec);
+}
+
+bool UserAnswerManager::startJournal(const QString &filename, qint64 *pLastTime)
 {
-    for(int row = 0; row < m_pProblem->getNumRows(); ++row) {
-        for(int col = 0; col < m_pProblem->getNumCols(); ++col) {
-            if(m_pProblem->getCellType(col, row) == problemdata::CellType::CellAnswer
-                    && m_pProblem->getAnswer(col, row) != m_pAnswer->getAnswer(col, row)) {
-                return false;
-            }
+    const int cols = m_pProblem->getNumCols();
+    const int rows = m_pProblem->getNumRows();
+    std::vector<JournalRecord> records;
+    m_pJournal.reset(new AnswerJournal(filename));
+
+    if(!AnswerJournal::readJournal(filename, cols, rows, records)) {
+        if(!m_pJournal->create(cols, rows))
+            m_pJournal.reset();
+        return false;
+    }
+
+    // replay; rebuilds the answers and the undo stack without any per-move signal
+    for(const auto &rec : records) {
+        const int i = m_pAnswer->getIndex(rec.col, rec.row);
+        if(rec.op == JournalOp::Update) {
+            CellData undoData;
+            undoData.p = QPoint(rec.col, rec.row);
+            undoData.answer = m_pAnswer->at(i);
+            m_undoStack.push(undoData);
+        } else if(!m_undoStack.empty()) {
+            m_undoStack.pop();
         }
+        m_pAnswer->setAt(i, static_cast<std::uint8_t>(rec.answer));
     }
 
+    if(!m_pJournal->openAppend(static_cast<int>(records.size())))
+        m_pJournal.reset();
+
+    if(records.empty())
+        return false;
+
+    if(pLastTime != nullptr)
+        *pLastTime = records.back().time;
+    // no undoable signal; the play has not started yet and picks up isUndoable() when it does
+    emit newUserAnswer(m_pAnswer);
     return true;
 }
 
+void UserAnswerManager::syncJournal()
+{
+    if(m_pJournal != nullptr)
+        m_pJournal->sync();
+}
+
+bool UserAnswerManager::archiveJournal(const QString &filename, int maxRecords)
+{
+    if(m_pJournal == nullptr)
+        return false;
+
+    const bool archived = m_pJournal->archive(filename);
+    m_pJournal.reset();
+    if(!archived)
+        return false;
+
+    // drop the oldest records beyond the cap; names break ties of the modified time
+    const QDir dir{QFileInfo(filename).absolutePath()};
+    QFileInfoList records{dir.entryInfoList(QStringList(QStringLiteral("*.kkj")), QDir::Files)};
+    if(records.size() > maxRecords) {
+        std::sort(records.begin(), records.end(), [](const QFileInfo &a, const QFileInfo &b) {
+            const QDateTime ta{a.lastModified()};
+            const QDateTime tb{b.lastModified()};
+            return ta != tb ? ta < tb : a.fileName() < b.fileName();
+        });
+        for(int k = 0; k < records.size() - maxRecords; ++k)
+            QFile::remove(records.at(k).absoluteFilePath());
+    }
+    return true;
+}
+
+bool UserAnswerManager::isSolved() const
+{
+    const std::uint8_t *pSolution = m_pProblem->getSolution();
+    for(int k = 0; k < m_pAnswer->getNumChunks(); ++k) {
+        const AnswerSpan chunk{m_pAnswer->getChunk(k)};
+        if(!sameAnswers(chunk.data, pSolution + k*UserAnswer::CHUNK_SIZE, chunk.size))
+            return false;
+    }
+    return true;
+}
+
+void UserAnswerManager::check(CheckResult &result) const
+{
+    const std::uint8_t *pSolution = m_pProblem->getSolution();
+    result.clear();
+    for(int k = 0; k < m_pAnswer->getNumChunks(); ++k) {
+        const AnswerSpan chunk{m_pAnswer->getChunk(k)};
+        const int base = k*UserAnswer::CHUNK_SIZE;
+        compareAnswers(chunk.data, pSolution + base, chunk.size, base, result);
+    }
+}
+
 /*
  * slots
  */
@@ -37,6 +133,7 @@ void UserAnswerManager::updateProblem(std::shared_ptr<problemdata::ProblemData>
     const int rows = pNewData->getNumRows();
     m_pProblem = pNewData;
     m_pAnswer.reset(new UserAnswer(cols, rows));
+    m_pJournal.reset();
     while(!m_undoStack.empty())
         m_undoStack.pop();
 
@@ -46,7 +143,8 @@ void UserAnswerManager::updateProblem(std::shared_ptr<problemdata::ProblemData>
 
 void UserAnswerManager::updateCellAnswer(CellData cellData)
 {
-    auto &cell = m_pAnswer->m_answers[m_pAnswer->getIndex(cellData.p.x(), cellData.p.y())];
+    const int i = m_pAnswer->getIndex(cellData.p.x(), cellData.p.y());
+    const int cell = m_pAnswer->at(i);
     if(cell != cellData.answer) {
         const bool undoableChanged = m_undoStack.empty();
 
@@ -57,7 +155,8 @@ void UserAnswerManager::updateCellAnswer(CellData cellData)
         m_undoStack.push(undoData);
 
         // update answer
-        cell = cellData.answer;
+        m_pAnswer->setAt(i, static_cast<std::uint8_t>(cellData.answer));
+        journal(JournalOp::Update, cellData.p, cellData.answer);
 
         // notify updates
         emit newCellAnswer(cellData.p);
@@ -79,8 +178,9 @@ void UserAnswerManager::undo()
         return;
 
     auto &undoData = m_undoStack.top();
-    auto &cell = m_pAnswer->m_answers[m_pAnswer->getIndex(undoData.p.x(), undoData.p.y())];
-    cell = undoData.answer;
+    m_pAnswer->setAt(m_pAnswer->getIndex(undoData.p.x(), undoData.p.y()),
+                     static_cast<std::uint8_t>(undoData.answer));
+    journal(JournalOp::Undo, undoData.p, undoData.answer);
     m_undoStack.pop();
 
     emit newCellAnswer(undoData.p);
@@ -5,7 +5,10 @@
 #include <QPoint>
 #include <memory>
 #include <stack>
+#include <functional>
 #include "useranswer.h"
+#include "answerjournal.h"
+#include "answercheck.h"
 #include "problemdata.h"
 
 namespace pd = problemdata;
@@ -13,6 +16,7 @@ namespace pd = problemdata;
 namespace useranswer {
 
 using SharedAnswer = std::shared_ptr<UserAnswer>;
+using AnswerSnapshot = std::shared_ptr<const UserAnswer>;
 
 struct CellData {
     QPoint p;
@@ -26,7 +30,14 @@ class UserAnswerManager : public QObject
     std::shared_ptr<UserAnswer> m_pAnswer;
     std::stack<CellData> m_undoStack;
 
+    // move journal for crash recovery
+    std::unique_ptr<AnswerJournal> m_pJournal;
+    std::function<qint64()> m_clock;
+    void journal(JournalOp op, const QPoint &p, int answer);
+
 public:
+    static const int MAX_RECORDS = 100;     // archived plays kept in a records directory
+
     UserAnswerManager();
     virtual ~UserAnswerManager();
 
@@ -34,7 +45,23 @@ public:
     UserAnswerManager &operator=(const UserAnswerManager&) = delete;
 
     bool isSolved() const;
+    void check(CheckResult &result) const;
+        // list wrong and empty answer cells; result is cleared first
+        // reuse result between calls to avoid allocations
     bool isUndoable() const {return !m_undoStack.empty();}
+    AnswerSnapshot snapshot() const {return AnswerSnapshot(new UserAnswer(*m_pAnswer));}
+        // immutable answers for background consumers; cheap, no cell is copied
+
+    void setClock(std::function<qint64()> clock) {m_clock = clock;}
+        // time source for journal records (elapsed play time)
+    bool startJournal(const QString &filename, qint64 *pLastTime = nullptr);
+        // start journaling the current problem's moves into filename
+        // an existing journal of the same board is replayed first;
+        // returns true if moves were recovered (*pLastTime receives the last timestamp)
+    void syncJournal();
+    bool archiveJournal(const QString &filename, int maxRecords = MAX_RECORDS);
+        // stop journaling and keep the journal as a record of the play
+        // only the newest maxRecords records (*.kkj) in the directory of filename are kept
 
 signals:
     void newUserAnswer(SharedAnswer pNewAns);
@@ -0,0 +1,33 @@
+#-------------------------------------------------
+#
+# Batch renderer: problem files -> PNG, SVG or PDF; PDF booklets
+#
+#-------------------------------------------------
+
+QT       += core gui concurrent svg
+
+TARGET = kkrrender
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += c++11
+
+TEMPLATE = app
+
+
+SOURCES += main.cpp \
+    batchrender.cpp \
+    ../Kakuro/boardrenderer.cpp \
+    ../Kakuro/boardexport.cpp \
+    ../Kakuro/problemdata.cpp \
+    ../Common/glyphatlas.cpp \
+    ../Common/boardpainter.cpp
+
+HEADERS += batchrender.h \
+    ../Kakuro/boardrenderer.h \
+    ../Kakuro/boardexport.h \
+    ../Kakuro/problemdata.h \
+    ../Common/cosmetic.h \
+    ../Common/glyphatlas.h \
+    ../Common/boardpainter.h
+
+INCLUDEPATH += ../Kakuro ../Common
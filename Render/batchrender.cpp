@@ -0,0 +1,127 @@
+#include "batchrender.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QSet>
+#include <QThreadPool>
+#include <QTextStream>
+#include <QtConcurrent>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "boardrenderer.h"
+#include "problemdata.h"
+
+namespace pd = problemdata;
+
+namespace {
+
+bool renderAs(const BoardRenderer &renderer, const QString &problemFile, const QString &outName,
+              const RenderOptions &options)
+{
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(problemFile)};
+    if(pData == nullptr)
+        return false;
+
+    const std::uint8_t *pAnswers = options.withSolution ? pData->getSolution() : nullptr;
+    const QString outBase{QDir(options.outputDir).filePath(outName)};
+
+    switch(options.format) {
+    case RenderOptions::Format::Svg:
+        return exportSvg(*pData, outBase + ".svg", pAnswers);
+    case RenderOptions::Format::Pdf:
+        return exportPdf(*pData, outBase + ".pdf", pAnswers);
+    case RenderOptions::Format::Png:
+        break;
+    }
+
+    const QImage image{renderer.render(*pData, pAnswers, options.scale)};
+    return image.save(outBase + ".png", "PNG");
+}
+
+struct RenderJob {
+    QString problemFile;
+    QString outName;        // unique within the batch
+    bool succeeded;
+};
+
+void runWorker(std::vector<RenderJob> *pJobs, std::atomic_int *pNext, const RenderOptions *pOptions)
+{
+    // one renderer per worker thread, so its glyph atlas is reused for every problem it takes;
+    // the atlas must not be shared between threads
+    const BoardRenderer renderer;
+    for(int k = pNext->fetch_add(1); k < static_cast<int>(pJobs->size()); k = pNext->fetch_add(1)) {
+        RenderJob &job = (*pJobs)[k];
+        job.succeeded = renderAs(renderer, job.problemFile, job.outName, *pOptions);
+    }
+}
+
+}   // namespace
+
+bool renderProblem(const QString &problemFile, const RenderOptions &options)
+{
+    const BoardRenderer renderer;
+    return renderAs(renderer, problemFile, QFileInfo(problemFile).completeBaseName(), options);
+}
+
+int renderBatch(const QStringList &problemFiles, const RenderOptions &options, int numThreads)
+{
+    std::vector<RenderJob> jobs;
+    jobs.reserve(problemFiles.size());
+    // compared case-insensitively, as the output directory may be
+    QSet<QString> usedNames;
+    for(const auto &f : problemFiles) {
+        const QString base{QFileInfo(f).completeBaseName()};
+        QString name{base};
+        for(int n = 2; usedNames.contains(name.toLower()); ++n)
+            name = base + '-' + QString::number(n);
+        usedNames.insert(name.toLower());
+
+        RenderJob job;
+        job.problemFile = f;
+        job.outName = name;
+        job.succeeded = false;
+        jobs.push_back(job);
+    }
+
+    // a pool of our own, so the caller's global pool is left as it is;
+    // the workers take the jobs in turn until none is left
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads);
+    std::atomic_int next{0};
+    const int numWorkers = std::min(numThreads, static_cast<int>(jobs.size()));
+    for(int w = 0; w < numWorkers; ++w)
+        QtConcurrent::run(&pool, runWorker, &jobs, &next, &options);
+    pool.waitForDone();
+
+    int numFailed = 0;
+    QTextStream err(stderr);
+    for(const auto &job : jobs) {
+        if(!job.succeeded) {
+            err << "failed: " << job.problemFile << endl;
+            ++numFailed;
+        }
+    }
+    return numFailed;
+}
+
+int renderBooklet(const QStringList &problemFiles, const QString &pdfFile, const BookletOptions &options)
+{
+    BookletWriter booklet{pdfFile, options};
+    if(!booklet.isOpen())
+        return -1;
+
+    int numFailed = 0;
+    QTextStream err(stderr);
+    for(const auto &f : problemFiles) {
+        std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(f)};
+        if(pData == nullptr || !booklet.addProblem(*pData)) {
+            err << "failed: " << f << endl;
+            ++numFailed;
+        }
+    }
+    if(!booklet.finish())
+        return -1;
+    return numFailed;
+}
@@ -0,0 +1,29 @@
+#ifndef BATCHRENDER_H
+#define BATCHRENDER_H
+
+#include <QString>
+#include <QStringList>
+#include "boardexport.h"
+
+struct RenderOptions {
+    enum class Format {Png, Svg, Pdf};
+
+    QString outputDir;
+    Format format;
+    qreal scale;            // PNG only
+    bool withSolution;      // fill the answer cells with the solution
+};
+
+bool renderProblem(const QString &problemFile, const RenderOptions &options);
+    // render one problem to outputDir/<base name>.png, .svg or .pdf
+
+int renderBatch(const QStringList &problemFiles, const RenderOptions &options, int numThreads);
+    // render problems in parallel on numThreads worker threads
+    // problems with the same base name are written as <base name>-2, -3, ...
+    // returns # of problems that failed to load or save
+
+int renderBooklet(const QStringList &problemFiles, const QString &pdfFile, const BookletOptions &options);
+    // lay out all problems in one PDF; each problem is loaded only while it is drawn
+    // returns # of problems that failed to load, or -1 if the PDF cannot be written
+
+#endif // BATCHRENDER_H
@@ -0,0 +1,106 @@
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QThread>
+#include "batchrender.h"
+
+int main(int argc, char *argv[])
+{
+    // fonts need a gui application, but no window system
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication a(argc, argv);
+    QCoreApplication::setApplicationName("kkrrender");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render kakuro problem files to PNG, SVG or PDF, or lay them out in a PDF booklet.");
+    parser.addHelpOption();
+    QCommandLineOption optOutput{QStringList() << "o" << "output", "Output directory.", "dir", "."};
+    QCommandLineOption optScale{QStringList() << "s" << "scale", "Scale of the images; 1.0 is the screen size.", "scale", "1.0"};
+    QCommandLineOption optSolution{"solution", "Fill the answer cells with the solution."};
+    QCommandLineOption optFormat{QStringList() << "f" << "format", "Output format: png, svg or pdf.", "format", "png"};
+    QCommandLineOption optBooklet{QStringList() << "b" << "booklet", "Write all problems to one PDF instead.", "file"};
+    QCommandLineOption optPerPage{"per-page", "Booklet layout as <cols>x<rows> puzzles per page.", "layout", "2x2"};
+    QCommandLineOption optJobs{QStringList() << "j" << "jobs", "Number of worker threads.", "n",
+                               QString::number(QThread::idealThreadCount())};
+    parser.addOption(optOutput);
+    parser.addOption(optScale);
+    parser.addOption(optSolution);
+    parser.addOption(optFormat);
+    parser.addOption(optBooklet);
+    parser.addOption(optPerPage);
+    parser.addOption(optJobs);
+    parser.addPositionalArgument("files", "Problem files to render.", "files...");
+    parser.process(a);
+
+    QTextStream err(stderr);
+    const QStringList files{parser.positionalArguments()};
+    if(files.isEmpty())
+        parser.showHelp(1);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if(parser.isSet(optBooklet)) {
+        BookletOptions booklet;
+        booklet.withSolution = parser.isSet(optSolution);
+        const QStringList layout{parser.value(optPerPage).split('x')};
+        bool okCols = false, okRows = false;
+        if(layout.size() == 2) {
+            booklet.cols = layout[0].toInt(&okCols);
+            booklet.rows = layout[1].toInt(&okRows);
+        }
+        if(!okCols || !okRows || booklet.cols < 1 || booklet.rows < 1) {
+            err << "invalid layout: " << parser.value(optPerPage) << endl;
+            return 1;
+        }
+
+        const int numFailed = renderBooklet(files, parser.value(optBooklet), booklet);
+        if(numFailed < 0) {
+            err << "cannot write " << parser.value(optBooklet) << endl;
+            return 2;
+        }
+        err << files.size() - numFailed << " laid out, " << numFailed << " failed in "
+            << timer.elapsed() << " ms" << endl;
+        return numFailed == 0 ? 0 : 2;
+    }
+
+    RenderOptions options;
+    options.outputDir = parser.value(optOutput);
+    options.withSolution = parser.isSet(optSolution);
+    const QString format{parser.value(optFormat).toLower()};
+    if(format == "png") {
+        options.format = RenderOptions::Format::Png;
+    } else if(format == "svg") {
+        options.format = RenderOptions::Format::Svg;
+    } else if(format == "pdf") {
+        options.format = RenderOptions::Format::Pdf;
+    } else {
+        err << "invalid format: " << parser.value(optFormat) << endl;
+        return 1;
+    }
+    bool ok;
+    options.scale = parser.value(optScale).toDouble(&ok);
+    if(!ok || options.scale <= 0) {
+        err << "invalid scale: " << parser.value(optScale) << endl;
+        return 1;
+    }
+    const int numThreads = parser.value(optJobs).toInt(&ok);
+    if(!ok || numThreads < 1) {
+        err << "invalid number of jobs: " << parser.value(optJobs) << endl;
+        return 1;
+    }
+    if(!QDir().mkpath(options.outputDir)) {
+        err << "cannot create " << options.outputDir << endl;
+        return 1;
+    }
+
+    const int numFailed = renderBatch(files, options, numThreads);
+    err << files.size() - numFailed << " rendered, " << numFailed << " failed in "
+        << timer.elapsed() << " ms" << endl;
+
+    return numFailed == 0 ? 0 : 2;
+}
@@ -17,6 +17,8 @@ public:
     void setClueRight(int c, int r, int cl) {m_kbm->setClueRight(c,r,cl);}
     void setClueDown(int c, int r, int cl) {m_kbm->setClueDown(c,r,cl);}
     void setAnswer(int c, int r, int a) { m_kbm->setAnswer(c,r,a);}
+    void beginEdit() {m_kbm->beginEdit();}
+    void endEdit() {m_kbm->endEdit();}
 };
 
 KkrBoardView::KkrBoardView(std::shared_ptr<KkrBoardManager> kbm)
@@ -49,6 +51,14 @@ private Q_SLOTS:
     void testCaseBoardDataMgrInvalidNoClue();
     void testCaseBoardDataMgrInvalidNoAnswer();
     void testCaseBoardDataMgrInvalidWrongSum();
+    void testCaseBoardDataMgrValidIncremental();
+    void testCaseBoardDataMgrUndo();
+    void testCaseBoardDataMgrDeriveClues();
+    void testCaseBoardDataMgrSetAnswers();
+    void testCaseBoardDataMgrBulk();
+    void testCaseBoardDataMgrResize();
+    void testCaseBoardDataMgrSnapshot();
+    void testCaseBoardDataMgrDirty();
 };
 
 EditorBoardTest::EditorBoardTest()
@@ -296,7 +306,7 @@ void EditorBoardTest::testCaseBoardDataMgrGet()
     KkrBoardManager kbm;
     kbm.slRead(pBd);
 
-    std::unique_ptr<BoardData> pBd2{kbm.getBoardData()};
+    std::shared_ptr<const BoardData> pBd2{kbm.getBoardData()};
 
     // size
     QCOMPARE(pBd2->getNumCols(), pBd->getNumCols());
@@ -573,6 +583,405 @@ void EditorBoardTest::testCaseBoardDataMgrInvalidWrongSum()
     QCOMPARE(kbm.isValid(), false);
 }
 
+void EditorBoardTest::testCaseBoardDataMgrValidIncremental()
+{
+    constexpr int cols = 4;
+    constexpr int rows = 5;
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slCreate(cols, rows);
+    QSignalSpy spy(pKbm.get(), &KkrBoardManager::sigValidityChanged);
+
+    KkrBoardView kbv{pKbm};
+
+    // same board as testCaseBoardDataMgrValid, built cell by cell
+    kbv.setCellType(1,1,CellType::CellClue);
+    kbv.setCellType(3,3,CellType::CellClue);
+    kbv.setCellType(3,4,CellType::CellClue);
+    QCOMPARE(pKbm->isValid(), false);
+    QVERIFY(spy.count() > 0);
+
+    kbv.setClueDown(2,0,30);
+    kbv.setClueDown(3,0,4);
+    kbv.setClueRight(1,1,7);
+    kbv.setClueDown(1,1,11);
+    kbv.setClueRight(0,2,13);
+    kbv.setClueRight(0,3,8);
+    kbv.setClueRight(0,4,17);
+    QCOMPARE(pKbm->isValid(), false);
+    QVERIFY(pKbm->getInvalidRuns().empty());
+
+    const int answers[rows][cols] = {
+        {0, 0, 0, 0},
+        {0, 0, 6, 1},
+        {0, 2, 8, 3},
+        {0, 1, 7, 0},
+        {0, 8, 9, 0},
+    };
+    for(int r = 1; r < rows; ++r)
+        for(int c = 1; c < cols; ++c)
+            if(answers[r][c] != 0)
+                kbv.setAnswer(c,r,answers[r][c]);
+    QCOMPARE(pKbm->isValid(), true);
+
+    // wrong sum
+    spy.clear();
+    kbv.setAnswer(1,4,7);
+    QCOMPARE(pKbm->isValid(), false);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(pKbm->getInvalidRuns().size(), static_cast<std::size_t>(2));
+    QCOMPARE(pKbm->isRunInvalid(0,4,KkrBoardManager::RunDir::Right), true);
+    QCOMPARE(pKbm->isRunInvalid(1,1,KkrBoardManager::RunDir::Down), true);
+    QCOMPARE(pKbm->isCellInvalid(1,4), false);
+
+    // repeated digit
+    kbv.setAnswer(2,4,7);
+    QCOMPARE(pKbm->isCellInvalid(1,4), true);
+    QCOMPARE(pKbm->isCellInvalid(2,4), true);
+    QCOMPARE(pKbm->isCellInvalid(1,3), false);
+
+    kbv.setAnswer(1,4,8);
+    kbv.setAnswer(2,4,9);
+    QCOMPARE(pKbm->isValid(), true);
+    QVERIFY(pKbm->getInvalidRuns().empty());
+
+    // cell type changes split and join the runs
+    kbv.setCellType(2,2,CellType::CellClue);
+    QCOMPARE(pKbm->isValid(), false);
+    kbv.setCellType(2,2,CellType::CellAnswer);
+    QCOMPARE(pKbm->isValid(), false);
+    kbv.setAnswer(2,2,8);
+    QCOMPARE(pKbm->isValid(), true);
+
+    // a clue without cells
+    kbv.setClueDown(3,3,5);
+    QCOMPARE(pKbm->isRunInvalid(3,3,KkrBoardManager::RunDir::Down), true);
+    kbv.setClueDown(3,3,CLOSED_CLUE);
+    QCOMPARE(pKbm->isValid(), true);
+}
+
+void EditorBoardTest::testCaseBoardDataMgrUndo()
+{
+    constexpr int cols = 10;
+    constexpr int rows = 4;
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slCreate(cols, rows);
+    QSignalSpy spy(pKbm.get(), &KkrBoardManager::sigUndoChanged);
+    QCOMPARE(pKbm->canUndo(), false);
+    QCOMPARE(pKbm->canRedo(), false);
+
+    KkrBoardView kbv{pKbm};
+
+    // one entry for the cell and the clues it closes
+    kbv.beginEdit();
+    kbv.setCellType(1,1,CellType::CellClue);
+    kbv.setClueRight(1,1,36);
+    kbv.endEdit();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(pKbm->canUndo(), true);
+    kbv.setAnswer(2,2,8);
+
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getAnswer(2,2), EMPTY_ANSWER);
+    QCOMPARE(pKbm->getCellType(1,1), CellType::CellClue);
+    QCOMPARE(pKbm->canRedo(), true);
+
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getCellType(1,1), CellType::CellAnswer);
+    QCOMPARE(pKbm->getAnswer(1,1), EMPTY_ANSWER);
+    QCOMPARE(pKbm->getClueDown(1,0), EMPTY_CLUE);
+    QCOMPARE(pKbm->getClueRight(0,1), EMPTY_CLUE);
+    QCOMPARE(pKbm->canUndo(), false);
+
+    pKbm->slRedo();
+    QCOMPARE(pKbm->getCellType(1,1), CellType::CellClue);
+    QCOMPARE(pKbm->getClueRight(1,1), 36);
+    QCOMPARE(pKbm->getClueDown(1,1), EMPTY_CLUE);
+    QCOMPARE(pKbm->getClueDown(1,0), CLOSED_CLUE);
+    QCOMPARE(pKbm->getClueRight(0,1), CLOSED_CLUE);
+    pKbm->slRedo();
+    QCOMPARE(pKbm->getAnswer(2,2), 8);
+    QCOMPARE(pKbm->canRedo(), false);
+
+    // a new edit drops the redo entries
+    pKbm->slUndo();
+    kbv.setAnswer(3,3,5);
+    QCOMPARE(pKbm->canRedo(), false);
+    QCOMPARE(pKbm->getAnswer(2,2), EMPTY_ANSWER);
+
+    // edits that change nothing leave no entry
+    pKbm->slUndo();
+    pKbm->slUndo();
+    QCOMPARE(pKbm->canUndo(), false);
+    kbv.beginEdit();
+    kbv.setAnswer(2,2,4);
+    kbv.setAnswer(2,2,EMPTY_ANSWER);
+    kbv.endEdit();
+    QCOMPARE(pKbm->canUndo(), false);
+
+    // a new board has no history
+    kbv.setAnswer(2,2,4);
+    pKbm->slCreate(cols, rows);
+    QCOMPARE(pKbm->canUndo(), false);
+    QCOMPARE(pKbm->canRedo(), false);
+}
+
+void EditorBoardTest::testCaseBoardDataMgrDeriveClues()
+{
+    // layout and answers of testCaseBoardDataMgrValid without the clues
+    constexpr int cols = 4;
+    constexpr int rows = 5;
+    std::shared_ptr<BoardData> pbd{new BoardData{cols, rows}};
+    pbd->setCellType(1,1,CellType::CellClue);
+    pbd->setCellType(3,3,CellType::CellClue);
+    pbd->setCellType(3,4,CellType::CellClue);
+    const int answers[rows][cols] = {
+        {0, 0, 0, 0},
+        {0, 0, 6, 1},
+        {0, 2, 8, 3},
+        {0, 1, 7, 0},
+        {0, 8, 9, 0},
+    };
+    for(int r = 1; r < rows; ++r)
+        for(int c = 1; c < cols; ++c)
+            if(answers[r][c] != 0)
+                pbd->setAnswer(c,r,answers[r][c]);
+
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slRead(pbd);
+    QCOMPARE(pKbm->isValid(), false);
+
+    pKbm->slDeriveClues();
+    QCOMPARE(pKbm->isValid(), true);
+    QCOMPARE(pKbm->getClueDown(2,0), 30);
+    QCOMPARE(pKbm->getClueRight(1,1), 7);
+    QCOMPARE(pKbm->getClueRight(0,4), 17);
+
+    // one undo entry
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getClueDown(2,0), EMPTY_CLUE);
+    QCOMPARE(pKbm->getClueRight(0,4), EMPTY_CLUE);
+    QCOMPARE(pKbm->canUndo(), false);
+    pKbm->slRedo();
+
+    // incremental
+    KkrBoardView kbv{pKbm};
+    pKbm->setAutoClues(true);
+    kbv.setAnswer(1,4,7);
+    QCOMPARE(pKbm->getClueRight(0,4), 16);
+    QCOMPARE(pKbm->getClueDown(1,1), 10);
+    QCOMPARE(pKbm->isValid(), true);
+
+    // runs with empty cells keep their clues
+    kbv.setAnswer(1,4,EMPTY_ANSWER);
+    QCOMPARE(pKbm->getClueRight(0,4), 16);
+
+    // the answer and its clues are undone together
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getAnswer(1,4), 7);
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getAnswer(1,4), 8);
+    QCOMPARE(pKbm->getClueRight(0,4), 17);
+    QCOMPARE(pKbm->getClueDown(1,1), 11);
+}
+
+void EditorBoardTest::testCaseBoardDataMgrSetAnswers()
+{
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slCreate(3, 3);
+    KkrBoardView kbv{pKbm};
+    kbv.setClueRight(0,1,4);
+    kbv.setClueRight(0,2,6);
+    kbv.setClueDown(1,0,3);
+    kbv.setClueDown(2,0,7);
+
+    // clue cells are skipped
+    const std::vector<int> answers = {9, 9, 9, 9, 1, 3, 9, 2, 4};
+    pKbm->slSetAnswers(answers);
+    QCOMPARE(pKbm->getAnswer(1,1), 1);
+    QCOMPARE(pKbm->getAnswer(2,2), 4);
+    QCOMPARE(pKbm->getClueRight(0,1), 4);
+    QCOMPARE(pKbm->isValid(), true);
+
+    // one undo entry
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getAnswer(1,1), EMPTY_ANSWER);
+    QCOMPARE(pKbm->getAnswer(2,2), EMPTY_ANSWER);
+    QCOMPARE(pKbm->getClueDown(2,0), 7);
+}
+
+void EditorBoardTest::testCaseBoardDataMgrBulk()
+{
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slCreate(6, 6);
+    KkrBoardView kbv{pKbm};
+    kbv.setAnswer(1,1,5);
+
+    // clue cells in a block; clues are open only next to answer cells
+    pKbm->fillCellType(QRect(1, 2, 2, 2), CellType::CellClue);
+    QCOMPARE(pKbm->getCellType(2,3), CellType::CellClue);
+    QCOMPARE(pKbm->getClueRight(0,2), CLOSED_CLUE);
+    QCOMPARE(pKbm->getClueDown(1,2), CLOSED_CLUE);
+    QCOMPARE(pKbm->getClueRight(1,3), CLOSED_CLUE);
+    QCOMPARE(pKbm->getClueRight(2,2), EMPTY_CLUE);
+    QCOMPARE(pKbm->getClueDown(2,3), EMPTY_CLUE);
+
+    // the frame stays clue cells
+    pKbm->fillCellType(QRect(0, 0, 2, 2), CellType::CellAnswer);
+    QCOMPARE(pKbm->getCellType(0,1), CellType::CellClue);
+    QCOMPARE(pKbm->getAnswer(1,1), 5);
+
+    // the runs are the same as on a board read afresh
+    auto sameValidation = [&pKbm]() {
+        std::shared_ptr<KkrBoardManager> pFresh{new KkrBoardManager};
+        pFresh->slRead(std::shared_ptr<const BoardData>(pKbm->getBoardData()));
+        return pFresh->getInvalidRuns() == pKbm->getInvalidRuns()
+                && pFresh->isValid() == pKbm->isValid();
+    };
+
+    // mirrored cell types and answers; the block keeps its shape
+    QVERIFY(pKbm->transformCells(QRect(1, 1, 3, 3), KkrBoardManager::Transform::MirrorLeftRight));
+    QCOMPARE(pKbm->getAnswer(3,1), 5);
+    QCOMPARE(pKbm->getCellType(1,2), CellType::CellAnswer);
+    QCOMPARE(pKbm->getCellType(3,2), CellType::CellClue);
+    QVERIFY(sameValidation());
+    QCOMPARE(pKbm->transformCells(QRect(1, 1, 3, 2), KkrBoardManager::Transform::RotateRight), false);
+
+    // copy and paste, clipped to the board
+    const KkrBoardManager::CellBlock block{pKbm->copyCells(QRect(1, 1, 3, 3))};
+    pKbm->pasteCells(4, 4, block);
+    QCOMPARE(pKbm->getCellType(4,5), CellType::CellAnswer);
+    QCOMPARE(pKbm->getCellType(5,5), CellType::CellClue);
+    QVERIFY(sameValidation());
+
+    // point symmetry of the whole answer area
+    pKbm->slCreate(6, 5);
+    pKbm->fillCellType(QRect(1, 1, 1, 2), CellType::CellClue);
+    QVERIFY(pKbm->applySymmetry(QRect(1, 1, 5, 4), KkrBoardManager::Symmetry::Point));
+    QCOMPARE(pKbm->getCellType(5,4), CellType::CellClue);
+    QCOMPARE(pKbm->getCellType(5,3), CellType::CellClue);
+    QCOMPARE(pKbm->getCellType(4,4), CellType::CellAnswer);
+    QCOMPARE(pKbm->applySymmetry(QRect(1, 1, 5, 4), KkrBoardManager::Symmetry::Rotational), false);
+    QVERIFY(sameValidation());
+
+    // one undo entry each
+    kbv.setAnswer(2,1,3);
+    pKbm->clearCells(QRect(0, 0, 6, 5));
+    QCOMPARE(pKbm->getAnswer(2,1), EMPTY_ANSWER);
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getAnswer(2,1), 3);
+    pKbm->slUndo();
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getCellType(5,4), CellType::CellAnswer);
+    QCOMPARE(pKbm->getCellType(1,2), CellType::CellClue);
+    pKbm->slUndo();
+    QCOMPARE(pKbm->getCellType(1,2), CellType::CellAnswer);
+    QCOMPARE(pKbm->canUndo(), false);
+}
+
+void EditorBoardTest::testCaseBoardDataMgrResize()
+{
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slCreate(4, 4);
+    KkrBoardView kbv{pKbm};
+    kbv.setCellType(2,2,CellType::CellClue);
+    kbv.setClueRight(0,1,6);
+    kbv.setAnswer(3,3,9);
+
+    // extend on the left and at the bottom
+    pKbm->slResize(1, 0, 0, 2);
+    QCOMPARE(pKbm->getNumCols(), 5);
+    QCOMPARE(pKbm->getNumRows(), 6);
+    QCOMPARE(pKbm->getCellType(3,2), CellType::CellClue);
+    QCOMPARE(pKbm->getAnswer(4,3), 9);
+    QCOMPARE(pKbm->getClueRight(0,1), 6);
+    QCOMPARE(pKbm->getCellType(1,1), CellType::CellAnswer);
+    QCOMPARE(pKbm->getClueDown(3,2), EMPTY_CLUE);
+    QCOMPARE(pKbm->getClueRight(0,5), EMPTY_CLUE);
+    QCOMPARE(pKbm->canUndo(), false);
+
+    // crop on the left and at the top; the answer next to the frame is gone
+    pKbm->slResize(-2, -1, 0, 0);
+    QCOMPARE(pKbm->getNumCols(), 3);
+    QCOMPARE(pKbm->getNumRows(), 5);
+    QCOMPARE(pKbm->getCellType(1,1), CellType::CellClue);
+    QCOMPARE(pKbm->getClueRight(1,1), EMPTY_CLUE);
+    QCOMPARE(pKbm->getClueRight(0,1), CLOSED_CLUE);
+    QCOMPARE(pKbm->getAnswer(2,2), 9);
+
+    std::shared_ptr<KkrBoardManager> pFresh{new KkrBoardManager};
+    pFresh->slRead(std::shared_ptr<const BoardData>(pKbm->getBoardData()));
+    QCOMPARE(pKbm->getInvalidRuns(), pFresh->getInvalidRuns());
+    QCOMPARE(pKbm->isValid(), pFresh->isValid());
+}
+
+void EditorBoardTest::testCaseBoardDataMgrSnapshot()
+{
+    // cells in more than one chunk
+    constexpr int cols = 100;
+    constexpr int rows = 100;
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slCreate(cols, rows);
+    KkrBoardView kbv{pKbm};
+    kbv.setAnswer(1,1,1);
+
+    // snapshots keep their contents while the board is edited
+    std::shared_ptr<const BoardData> pSnap{pKbm->getBoardData()};
+    kbv.setAnswer(1,1,2);
+    kbv.setAnswer(98,98,3);
+    kbv.setCellType(50,50,CellType::CellClue);
+    pKbm->clearCells(QRect(0, 0, cols, 2));
+    QCOMPARE(pSnap->getAnswer(1,1), 1);
+    QCOMPARE(pSnap->getAnswer(98,98), EMPTY_ANSWER);
+    QCOMPARE(pSnap->getCellType(50,50), CellType::CellAnswer);
+    QCOMPARE(pKbm->getAnswer(98,98), 3);
+
+    std::shared_ptr<const BoardData> pSnap2{pKbm->getBoardData()};
+    pKbm->slResize(0, 0, -50, -50);
+    QCOMPARE(pSnap2->getNumCols(), cols);
+    QCOMPARE(pSnap2->getAnswer(98,98), 3);
+
+    // so do copies
+    BoardData copy{*pSnap2};
+    copy.setAnswer(98,98,4);
+    QCOMPARE(pSnap2->getAnswer(98,98), 3);
+    QCOMPARE(copy.getAnswer(98,98), 4);
+    QCOMPARE(copy.getCellType(50,50), CellType::CellClue);
+}
+
+void EditorBoardTest::testCaseBoardDataMgrDirty()
+{
+    std::shared_ptr<KkrBoardManager> pKbm{new KkrBoardManager};
+    pKbm->slCreate(5, 5);
+    QSignalSpy spy(pKbm.get(), &KkrBoardManager::sigEdited);
+    KkrBoardView kbv{pKbm};
+
+    // a digit alone repaints its cell
+    kbv.setAnswer(2,2,5);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toRect(), QRect(2,2,1,1));
+
+    // a repeated digit marks the whole run and its clue
+    kbv.setAnswer(3,2,5);
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(1).at(0).toRect(), QRect(0,2,5,1));
+
+    // one entry for a group; undo repaints the same cells
+    kbv.beginEdit();
+    kbv.setAnswer(1,1,1);
+    kbv.setAnswer(1,3,2);
+    kbv.endEdit();
+    QCOMPARE(spy.count(), 3);
+    QCOMPARE(spy.at(2).at(0).toRect(), QRect(1,1,1,3));
+    pKbm->slUndo();
+    QCOMPARE(spy.count(), 4);
+    QCOMPARE(spy.at(3).at(0).toRect(), QRect(1,1,1,3));
+
+    // a clue cell splits the row and the column through it
+    kbv.setCellType(2,2,CellType::CellClue);
+    QCOMPARE(spy.count(), 5);
+    QCOMPARE(spy.at(4).at(0).toRect(), QRect(0,2,5,1).united(QRect(2,0,1,5)));
+}
+
 QTEST_APPLESS_MAIN(EditorBoardTest)
 
 #include "tst_editorboardtest.moc"
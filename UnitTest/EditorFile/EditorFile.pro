@@ -0,0 +1,30 @@
+#-------------------------------------------------
+#
+# Editor problem file test
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_editorfiletest
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += testcase c++11
+
+TEMPLATE = app
+
+
+SOURCES += tst_editorfiletest.cpp \
+    ../../Editor/kkrboardmanager.cpp \
+    ../../Editor/metadatamanager.cpp \
+    ../../Editor/boardfile.cpp \
+    ../../Kakuro/problemdata.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+HEADERS += \
+    ../../Editor/kkrboardmanager.h \
+    ../../Editor/metadatamanager.h \
+    ../../Editor/boardfile.h \
+    ../../Kakuro/problemdata.h
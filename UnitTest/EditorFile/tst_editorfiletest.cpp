@@ -0,0 +1,191 @@
+#include <QString>
+#include <QtTest>
+#include <QTemporaryDir>
+#include <memory>
+#include "../../Editor/kkrboardmanager.h"
+#include "../../Editor/boardfile.h"
+#include "../../Kakuro/problemdata.h"
+
+class EditorFileTest : public QObject
+{
+    Q_OBJECT
+
+    // the board of the editor board tests; no answers unless complete
+    static std::unique_ptr<BoardData> makeBoard(bool complete);
+
+public:
+    EditorFileTest();
+
+private Q_SLOTS:
+    void testCaseRoundTrip();
+    void testCaseUnfinished();
+    void testCasePlayer();
+    void testCaseInvalid();
+};
+
+EditorFileTest::EditorFileTest()
+{
+}
+
+std::unique_ptr<BoardData> EditorFileTest::makeBoard(bool complete)
+{
+    constexpr int cols = 4;
+    constexpr int rows = 5;
+    std::unique_ptr<BoardData> pBd{new BoardData{cols, rows}};
+    pBd->setClueDown(2,0,30);
+    pBd->setClueDown(3,0,4);
+    pBd->setCellType(1,1,CellType::CellClue);
+    pBd->setClueRight(1,1,7);
+    pBd->setClueDown(1,1,11);
+    pBd->setClueRight(0,2,13);
+    pBd->setClueRight(0,3,8);
+    pBd->setCellType(3,3,CellType::CellClue);
+    pBd->setClueRight(0,4,17);
+    pBd->setCellType(3,4,CellType::CellClue);
+
+    // closed where no answer cell follows, as the editor keeps them
+    for(int r = 0; r < rows; ++r) {
+        for(int c = 0; c < cols; ++c) {
+            if(pBd->getCellType(c,r) != CellType::CellClue)
+                continue;
+            if(c == cols-1 || pBd->getCellType(c+1,r) == CellType::CellClue)
+                pBd->setClueRight(c,r,CLOSED_CLUE);
+            if(r == rows-1 || pBd->getCellType(c,r+1) == CellType::CellClue)
+                pBd->setClueDown(c,r,CLOSED_CLUE);
+        }
+    }
+
+    if(complete) {
+        const int answers[rows][cols] = {
+            {0, 0, 0, 0},
+            {0, 0, 6, 1},
+            {0, 2, 8, 3},
+            {0, 1, 7, 0},
+            {0, 8, 9, 0},
+        };
+        for(int r = 1; r < rows; ++r)
+            for(int c = 1; c < cols; ++c)
+                if(answers[r][c] != 0)
+                    pBd->setAnswer(c,r,answers[r][c]);
+    }
+    return pBd;
+}
+
+void EditorFileTest::testCaseRoundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName{dir.path() + "/roundtrip.kkr"};
+
+    std::unique_ptr<BoardData> pBd{makeBoard(true)};
+    const MetaData meta{QString::fromUtf8("\xe4\xbd\x9c\xe8\x80\x85"), 600, 300, 120, 60};
+    QVERIFY(saveBoardFile(fileName, *pBd, meta));
+
+    const BoardFile file{loadBoardFile(fileName)};
+    QVERIFY(file.pBoard != nullptr);
+    QVERIFY(file.pMeta != nullptr);
+
+    QCOMPARE(file.pBoard->getNumCols(), pBd->getNumCols());
+    QCOMPARE(file.pBoard->getNumRows(), pBd->getNumRows());
+    for(int r = 0; r < pBd->getNumRows(); ++r) {
+        for(int c = 0; c < pBd->getNumCols(); ++c) {
+            QCOMPARE(file.pBoard->getCellType(c,r), pBd->getCellType(c,r));
+            if(pBd->getCellType(c,r) == CellType::CellAnswer) {
+                QCOMPARE(file.pBoard->getAnswer(c,r), pBd->getAnswer(c,r));
+            } else {
+                QCOMPARE(file.pBoard->getClueRight(c,r), pBd->getClueRight(c,r));
+                QCOMPARE(file.pBoard->getClueDown(c,r), pBd->getClueDown(c,r));
+            }
+        }
+    }
+
+    QCOMPARE(file.pMeta->getAuthor(), meta.getAuthor());
+    QCOMPARE(file.pMeta->getBeginnerTime(), 600);
+    QCOMPARE(file.pMeta->getIntermediateTime(), 300);
+    QCOMPARE(file.pMeta->getAdvancedTime(), 120);
+    QCOMPARE(file.pMeta->getExpertTime(), 60);
+}
+
+void EditorFileTest::testCaseUnfinished()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName{dir.path() + "/unfinished.kkr"};
+
+    std::unique_ptr<BoardData> pBd{makeBoard(false)};
+    pBd->setClueRight(0,4,EMPTY_CLUE);
+    const MetaData meta{QString(), 0, 0, 0, 0};
+    QVERIFY(saveBoardFile(fileName, *pBd, meta));
+
+    const BoardFile file{loadBoardFile(fileName)};
+    QVERIFY(file.pBoard != nullptr);
+    QCOMPARE(file.pBoard->getAnswer(2,2), EMPTY_ANSWER);
+    // no clue yet, but answer cells follow
+    QCOMPARE(file.pBoard->getClueRight(0,4), EMPTY_CLUE);
+    // nothing follows
+    QCOMPARE(file.pBoard->getClueRight(3,3), CLOSED_CLUE);
+    QCOMPARE(file.pBoard->getClueDown(3,3), CLOSED_CLUE);
+    QCOMPARE(file.pBoard->getClueRight(1,0), CLOSED_CLUE);
+    QCOMPARE(file.pMeta->getAuthor(), QString());
+
+    // the player cannot open unfinished problems
+    std::unique_ptr<problemdata::ProblemData> pPd{problemdata::ProblemData::problemLoader(fileName)};
+    QVERIFY(pPd == nullptr);
+}
+
+void EditorFileTest::testCasePlayer()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName{dir.path() + "/player.kkr"};
+
+    std::unique_ptr<BoardData> pBd{makeBoard(true)};
+    const MetaData meta{"author", 600, 300, 120, 60};
+    QVERIFY(saveBoardFile(fileName, *pBd, meta));
+
+    // meta data after the cells is ignored by the player
+    std::unique_ptr<problemdata::ProblemData> pPd{problemdata::ProblemData::problemLoader(fileName)};
+    QVERIFY(pPd != nullptr);
+    QCOMPARE(pPd->getNumCols(), 4);
+    QCOMPARE(pPd->getNumRows(), 5);
+    QCOMPARE(pPd->getClueDown(2,0), 30);
+    QCOMPARE(pPd->getClueRight(1,1), 7);
+    QCOMPARE(pPd->getClueRight(3,3), problemdata::CLOSED_CLUE);
+    QCOMPARE(pPd->getAnswer(2,2), 8);
+}
+
+void EditorFileTest::testCaseInvalid()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // missing file
+    BoardFile file{loadBoardFile(dir.path() + "/missing.kkr")};
+    QVERIFY(file.pBoard == nullptr);
+
+    // truncated meta data
+    const QString fileName{dir.path() + "/truncated.kkr"};
+    std::unique_ptr<BoardData> pBd{makeBoard(true)};
+    const MetaData meta{"author", 600, 300, 120, 60};
+    QVERIFY(saveBoardFile(fileName, *pBd, meta));
+    QFile f{fileName};
+    QVERIFY(f.open(QIODevice::ReadWrite));
+    QVERIFY(f.resize(f.size() - 2));
+    f.close();
+    file = loadBoardFile(fileName);
+    QVERIFY(file.pBoard == nullptr);
+    QVERIFY(file.pMeta == nullptr);
+
+    // a size far beyond the cells in the file
+    const QString hugeName{dir.path() + "/huge.kkr"};
+    QFile huge{hugeName};
+    QVERIFY(huge.open(QIODevice::WriteOnly));
+    huge.write("KKRP0001\xff\xff\xff\xff", 12);
+    huge.close();
+    file = loadBoardFile(hugeName);
+    QVERIFY(file.pBoard == nullptr);
+}
+
+QTEST_APPLESS_MAIN(EditorFileTest)
+
+#include "tst_editorfiletest.moc"
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# Editor layout generator test
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_editorlayouttest
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += testcase c++11
+
+TEMPLATE = app
+
+
+SOURCES += tst_editorlayouttest.cpp \
+    ../../Editor/layoutgenerator.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+HEADERS += \
+    ../../Editor/layoutgenerator.h
@@ -0,0 +1,155 @@
+#include <QString>
+#include <QtTest>
+#include <vector>
+#include "../../Editor/layoutgenerator.h"
+
+class EditorLayoutTest : public QObject
+{
+    Q_OBJECT
+
+    typedef std::vector<std::uint8_t> Layout;
+
+    // runs of 2-9 answer cells, all connected
+    static bool isValid(const Layout &layout, int cols, int rows);
+    static bool isPointSymmetric(const Layout &layout, int cols, int rows);
+    static bool isRotationSymmetric(const Layout &layout, int size);
+
+public:
+    EditorLayoutTest();
+
+private Q_SLOTS:
+    void testCaseValid();
+    void testCaseSymmetry();
+    void testCaseRejected();
+};
+
+EditorLayoutTest::EditorLayoutTest()
+{
+}
+
+bool EditorLayoutTest::isValid(const Layout &layout, int cols, int rows)
+{
+    auto isAnswer = [&](int c, int r) {
+        return 0 <= c && c < cols && 0 <= r && r < rows && layout[c + r * cols] == 0;
+    };
+
+    int numAnswers = 0;
+    int start = -1;
+    for(int r = 0; r < rows; ++r) {
+        for(int c = 0; c < cols; ++c) {
+            if(!isAnswer(c, r))
+                continue;
+            ++numAnswers;
+            start = c + r * cols;
+            // from the first cell of each run
+            if(!isAnswer(c-1, r)) {
+                int length = 0;
+                while(isAnswer(c+length, r))
+                    ++length;
+                if(length < 2 || length > 9)
+                    return false;
+            }
+            if(!isAnswer(c, r-1)) {
+                int length = 0;
+                while(isAnswer(c, r+length))
+                    ++length;
+                if(length < 2 || length > 9)
+                    return false;
+            }
+        }
+    }
+    if(numAnswers == 0)
+        return false;
+
+    std::vector<bool> reached(layout.size(), false);
+    std::vector<int> queue{start};
+    reached[start] = true;
+    for(std::size_t head = 0; head < queue.size(); ++head) {
+        const int c = queue[head] % cols;
+        const int r = queue[head] / cols;
+        const int neighbours[4][2] = {{c-1, r}, {c+1, r}, {c, r-1}, {c, r+1}};
+        for(const auto &n : neighbours) {
+            if(isAnswer(n[0], n[1]) && !reached[n[0] + n[1] * cols]) {
+                reached[n[0] + n[1] * cols] = true;
+                queue.push_back(n[0] + n[1] * cols);
+            }
+        }
+    }
+    return static_cast<int>(queue.size()) == numAnswers;
+}
+
+bool EditorLayoutTest::isPointSymmetric(const Layout &layout, int cols, int rows)
+{
+    for(int r = 0; r < rows; ++r)
+        for(int c = 0; c < cols; ++c)
+            if(layout[c + r * cols] != layout[(cols-1-c) + (rows-1-r) * cols])
+                return false;
+    return true;
+}
+
+bool EditorLayoutTest::isRotationSymmetric(const Layout &layout, int size)
+{
+    for(int r = 0; r < size; ++r)
+        for(int c = 0; c < size; ++c)
+            if(layout[c + r * size] != layout[(size-1-r) + c * size])
+                return false;
+    return true;
+}
+
+void EditorLayoutTest::testCaseValid()
+{
+    constexpr int cols = 20;
+    constexpr int rows = 12;
+    LayoutGenerator generator{cols, rows, 25, LayoutGenerator::Symmetry::None, 1};
+    Layout layout;
+    int numGenerated = 0;
+    for(int k = 0; k < 100; ++k) {
+        if(!generator.generate(layout))
+            continue;
+        ++numGenerated;
+        QCOMPARE(static_cast<int>(layout.size()), cols * rows);
+        QVERIFY(isValid(layout, cols, rows));
+    }
+    QVERIFY(numGenerated > 0);
+}
+
+void EditorLayoutTest::testCaseSymmetry()
+{
+    Layout layout;
+
+    // each generator must produce layouts on its own
+    int numPoint = 0;
+    LayoutGenerator point{15, 10, 25, LayoutGenerator::Symmetry::Point, 2};
+    for(int k = 0; k < 100; ++k) {
+        if(!point.generate(layout))
+            continue;
+        ++numPoint;
+        QVERIFY(isValid(layout, 15, 10));
+        QVERIFY(isPointSymmetric(layout, 15, 10));
+    }
+    QVERIFY(numPoint > 0);
+
+    int numRotational = 0;
+    LayoutGenerator rotational{13, 13, 25, LayoutGenerator::Symmetry::Rotational, 3};
+    for(int k = 0; k < 100; ++k) {
+        if(!rotational.generate(layout))
+            continue;
+        ++numRotational;
+        QVERIFY(isValid(layout, 13, 13));
+        QVERIFY(isRotationSymmetric(layout, 13));
+    }
+    QVERIFY(numRotational > 0);
+}
+
+void EditorLayoutTest::testCaseRejected()
+{
+    // rotational symmetry needs a square area
+    Layout layout;
+    LayoutGenerator generator{13, 12, 25, LayoutGenerator::Symmetry::Rotational, 4};
+    QCOMPARE(generator.generate(layout), false);
+    QVERIFY(layout.empty());
+}
+
+QTEST_APPLESS_MAIN(EditorLayoutTest)
+
+#include "tst_editorlayouttest.moc"
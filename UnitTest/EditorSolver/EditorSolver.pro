@@ -0,0 +1,26 @@
+#-------------------------------------------------
+#
+# Editor solution counter test
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_editorsolvertest
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += testcase c++11
+
+TEMPLATE = app
+
+
+SOURCES += tst_editorsolvertest.cpp \
+    ../../Editor/kkrboardmanager.cpp \
+    ../../Editor/kkrsolver.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+HEADERS += \
+    ../../Editor/kkrboardmanager.h \
+    ../../Editor/kkrsolver.h
@@ -0,0 +1,142 @@
+#include <QString>
+#include <QtTest>
+#include <algorithm>
+#include "../../Editor/kkrboardmanager.h"
+#include "../../Editor/kkrsolver.h"
+
+class EditorSolverTest : public QObject
+{
+    Q_OBJECT
+
+    // 2x2 answer cells with the clues (right of row 1, right of row 2, down of col 1, down of col 2)
+    static void setSquare(BoardData &bd, int row1, int row2, int col1, int col2);
+
+public:
+    EditorSolverTest();
+
+private Q_SLOTS:
+    void testCaseUnique();
+    void testCaseMultiple();
+    void testCaseNoSolution();
+    void testCaseIncomplete();
+    void testCaseCancel();
+    void testCaseProgress();
+};
+
+EditorSolverTest::EditorSolverTest()
+{
+}
+
+void EditorSolverTest::setSquare(BoardData &bd, int row1, int row2, int col1, int col2)
+{
+    bd.setClueRight(0,1,row1);
+    bd.setClueRight(0,2,row2);
+    bd.setClueDown(1,0,col1);
+    bd.setClueDown(2,0,col2);
+}
+
+void EditorSolverTest::testCaseUnique()
+{
+    // same layout as the editor board tests; the answers are not entered
+    constexpr int cols = 4;
+    constexpr int rows = 5;
+    BoardData bd{cols, rows};
+    bd.setClueDown(2,0,30);
+    bd.setClueDown(3,0,4);
+    bd.setCellType(1,1,CellType::CellClue);
+    bd.setClueRight(1,1,7);
+    bd.setClueDown(1,1,11);
+    bd.setClueRight(0,2,13);
+    bd.setClueRight(0,3,8);
+    bd.setCellType(3,3,CellType::CellClue);
+    bd.setClueRight(0,4,17);
+    bd.setCellType(3,4,CellType::CellClue);
+
+    KkrSolver solver{bd};
+    QCOMPARE(solver.solve(), KkrSolver::Result::Unique);
+    QVERIFY(solver.getDifferingCells().empty());
+
+    const int expected[rows][cols] = {
+        {0, 0, 0, 0},
+        {0, 0, 6, 1},
+        {0, 2, 8, 3},
+        {0, 1, 7, 0},
+        {0, 8, 9, 0},
+    };
+    const auto &solution = solver.getSolution();
+    QCOMPARE(static_cast<int>(solution.size()), cols * rows);
+    for(int r = 0; r < rows; ++r)
+        for(int c = 0; c < cols; ++c)
+            QCOMPARE(solution[c + r * cols], expected[r][c]);
+}
+
+void EditorSolverTest::testCaseMultiple()
+{
+    // 1 2 / 2 1 and 2 1 / 1 2
+    BoardData bd{3, 3};
+    setSquare(bd, 3, 3, 3, 3);
+
+    KkrSolver solver{bd};
+    QCOMPARE(solver.solve(), KkrSolver::Result::Multiple);
+
+    std::vector<int> differing{solver.getDifferingCells()};
+    std::sort(differing.begin(), differing.end());
+    QCOMPARE(differing, (std::vector<int>{4, 5, 7, 8}));
+}
+
+void EditorSolverTest::testCaseNoSolution()
+{
+    // the rows add up to 6, the columns to 7
+    BoardData bd{3, 3};
+    setSquare(bd, 3, 3, 3, 4);
+
+    KkrSolver solver{bd};
+    QCOMPARE(solver.solve(), KkrSolver::Result::NoSolution);
+
+    // run longer than 9 cells
+    BoardData bd2{12, 2};
+    for(int c = 1; c < 12; ++c)
+        bd2.setClueDown(c,0,c < 10 ? c : 1);
+    bd2.setClueRight(0,1,45);
+    KkrSolver solver2{bd2};
+    QCOMPARE(solver2.solve(), KkrSolver::Result::NoSolution);
+}
+
+void EditorSolverTest::testCaseIncomplete()
+{
+    BoardData bd{3, 3};
+    setSquare(bd, 3, 3, 3, EMPTY_CLUE);
+
+    KkrSolver solver{bd};
+    QCOMPARE(solver.solve(), KkrSolver::Result::Incomplete);
+}
+
+void EditorSolverTest::testCaseCancel()
+{
+    BoardData bd{3, 3};
+    setSquare(bd, 3, 3, 3, 3);
+
+    const std::atomic_bool cancel{true};
+    KkrSolver solver{bd};
+    QCOMPARE(solver.solve(&cancel), KkrSolver::Result::Cancelled);
+}
+
+void EditorSolverTest::testCaseProgress()
+{
+    // 1 3 / 2 4
+    BoardData bd{3, 3};
+    setSquare(bd, 4, 6, 3, 7);
+
+    std::atomic_int progress{-1};
+    KkrSolver solver{bd};
+    QCOMPARE(solver.solve(nullptr, &progress), KkrSolver::Result::Unique);
+    QCOMPARE(progress.load(), 100);
+
+    const std::atomic_bool cancel{true};
+    QCOMPARE(solver.solve(&cancel, &progress), KkrSolver::Result::Cancelled);
+    QCOMPARE(progress.load(), 0);
+}
+
+QTEST_APPLESS_MAIN(EditorSolverTest)
+
+#include "tst_editorsolvertest.moc"
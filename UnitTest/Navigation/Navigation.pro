@@ -0,0 +1,26 @@
+#-------------------------------------------------
+#
+# Cursor navigation table test
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_navigationtest
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += testcase
+CONFIG   += c++11
+
+TEMPLATE = app
+
+
+SOURCES += tst_navigationtest.cpp \
+    mock4navigation.cpp \
+    ../../Kakuro/navigationtable.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+HEADERS += \
+    ../../Kakuro/navigationtable.h
@@ -0,0 +1,73 @@
+#include "../../Kakuro/problemdata.h"
+#include <QStringList>
+#include <vector>
+
+namespace problemdata {
+
+class ProblemData_int {
+public:
+    int cols;
+    int rows;
+    std::vector<CellType> types;
+    std::vector<std::uint8_t> solution;
+};
+
+ProblemData::ProblemData(std::unique_ptr<ProblemData_int> m) : m_(std::move(m))
+{
+}
+
+ProblemData::~ProblemData()
+{
+}
+
+int ProblemData::getNumCols() const
+{
+    return m_->cols;
+}
+
+int ProblemData::getNumRows() const
+{
+    return m_->rows;
+}
+
+CellType ProblemData::getCellType(int col, int row) const
+{
+    return m_->types[col + row * m_->cols];
+}
+
+int ProblemData::getClueRight(int, int) const
+{
+    return CLOSED_CLUE;
+}
+
+int ProblemData::getClueDown(int, int) const
+{
+    return CLOSED_CLUE;
+}
+
+int ProblemData::getAnswer(int, int) const
+{
+    return 1;
+}
+
+const std::uint8_t *ProblemData::getSolution() const
+{
+    return m_->solution.data();
+}
+
+ProblemData *ProblemData::problemLoader(const QString &filename)
+    // filename is the layout, rows separated by '/'; '#' is a clue cell, '.' an answer cell
+{
+    ProblemData * pPd = new ProblemData(std::unique_ptr<ProblemData_int>(new ProblemData_int));
+    const QStringList rows = filename.split('/');
+    pPd->m_->cols = rows[0].size();
+    pPd->m_->rows = rows.size();
+    for(const auto &row : rows)
+        for(const QChar ch : row)
+            pPd->m_->types.push_back(ch == '#' ? CellType::CellClue : CellType::CellAnswer);
+    pPd->m_->solution.assign(pPd->m_->types.size(), 0);
+
+    return pPd;
+}
+
+}
@@ -0,0 +1,135 @@
+#include <QString>
+#include <QtTest>
+#include <memory>
+#include "../../Kakuro/navigationtable.h"
+
+namespace pd = problemdata;
+using Dir = NavigationTable::Direction;
+
+/*
+ * board used in the tests; cell index = col + row * 5
+ *   #####      0  1  2  3  4
+ *   #..#.      5  6  7  8  9
+ *   #.#..     10 11 12 13 14
+ *   #...#     15 16 17 18 19
+ */
+static const char LAYOUT[] = "#####/#..#./#.#../#...#";
+
+class NavigationTest : public QObject
+{
+    Q_OBJECT
+    NavigationTable m_nav;
+
+public:
+    NavigationTest();
+
+private Q_SLOTS:
+    void init();
+    void testCaseFirstCell();
+    void testCaseStep();
+    void testCaseEdge();
+    void testCaseRun();
+    void testCaseEmpty();
+    void testCaseNoAnswerCell();
+};
+
+NavigationTest::NavigationTest()
+{
+}
+
+void NavigationTest::init()
+{
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(LAYOUT)};
+    m_nav.build(*pData);
+}
+
+void NavigationTest::testCaseFirstCell()
+{
+    QCOMPARE(m_nav.getFirstCell(), 6);
+}
+
+void NavigationTest::testCaseStep()
+{
+    // clue cells are skipped
+    QCOMPARE(m_nav.step(7, Dir::Right), 9);
+    QCOMPARE(m_nav.step(9, Dir::Left), 7);
+    QCOMPARE(m_nav.step(7, Dir::Down), 17);
+    QCOMPARE(m_nav.step(17, Dir::Up), 7);
+    QCOMPARE(m_nav.step(13, Dir::Left), 11);
+    QCOMPARE(m_nav.step(11, Dir::Right), 13);
+
+    // edges of the board
+    QCOMPARE(m_nav.step(6, Dir::Up), NavigationTable::NO_CELL);
+    QCOMPARE(m_nav.step(6, Dir::Left), NavigationTable::NO_CELL);
+    QCOMPARE(m_nav.step(9, Dir::Right), NavigationTable::NO_CELL);
+    QCOMPARE(m_nav.step(18, Dir::Down), NavigationTable::NO_CELL);
+}
+
+void NavigationTest::testCaseEdge()
+{
+    QCOMPARE(m_nav.edge(16, Dir::Up), 6);
+    QCOMPARE(m_nav.edge(6, Dir::Down), 16);
+    QCOMPARE(m_nav.edge(14, Dir::Left), 11);
+    QCOMPARE(m_nav.edge(11, Dir::Right), 14);
+    QCOMPARE(m_nav.edge(18, Dir::Up), 13);
+    QCOMPARE(m_nav.edge(6, Dir::Up), 6);
+}
+
+void NavigationTest::testCaseRun()
+{
+    // runs start at 6, 9, 11, 13 and 16
+    QCOMPARE(m_nav.nextRun(6), 9);
+    QCOMPARE(m_nav.nextRun(7), 9);
+    QCOMPARE(m_nav.nextRun(14), 16);
+    QCOMPARE(m_nav.nextRun(17), 6);
+
+    QCOMPARE(m_nav.prevRun(7), 6);
+    QCOMPARE(m_nav.prevRun(6), 16);
+    QCOMPARE(m_nav.prevRun(14), 13);
+    QCOMPARE(m_nav.prevRun(13), 11);
+}
+
+void NavigationTest::testCaseEmpty()
+{
+    // all answer cells are empty after build
+    QCOMPARE(m_nav.nextEmpty(6), 7);
+    QCOMPARE(m_nav.prevEmpty(6), 18);
+
+    m_nav.setEmpty(7, false);
+    m_nav.setEmpty(9, false);
+    QCOMPARE(m_nav.nextEmpty(6), 11);
+    QCOMPARE(m_nav.prevEmpty(11), 6);
+
+    // clue cells never become empty
+    m_nav.setEmpty(19, true);
+    QCOMPARE(m_nav.nextEmpty(18), 6);
+
+    // only the current cell left
+    for(const int cell : {11, 13, 14, 16, 17, 18})
+        m_nav.setEmpty(cell, false);
+    QCOMPARE(m_nav.nextEmpty(6), NavigationTable::NO_CELL);
+    QCOMPARE(m_nav.prevEmpty(6), NavigationTable::NO_CELL);
+    QCOMPARE(m_nav.nextEmpty(7), 6);
+
+    m_nav.setEmpty(9, true);
+    QCOMPARE(m_nav.nextEmpty(6), 9);
+    QCOMPARE(m_nav.prevEmpty(6), 9);
+}
+
+void NavigationTest::testCaseNoAnswerCell()
+{
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader("###/###")};
+    NavigationTable nav;
+    nav.build(*pData);
+
+    QCOMPARE(nav.getFirstCell(), NavigationTable::NO_CELL);
+    QCOMPARE(nav.step(0, Dir::Right), NavigationTable::NO_CELL);
+    QCOMPARE(nav.edge(4, Dir::Up), NavigationTable::NO_CELL);
+    QCOMPARE(nav.nextRun(0), NavigationTable::NO_CELL);
+    QCOMPARE(nav.nextEmpty(0), NavigationTable::NO_CELL);
+    QCOMPARE(nav.prevEmpty(0), NavigationTable::NO_CELL);
+}
+
+QTEST_APPLESS_MAIN(NavigationTest)
+
+#include "tst_navigationtest.moc"
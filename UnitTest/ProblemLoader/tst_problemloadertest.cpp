@@ -270,6 +270,11 @@ void ProblemLoaderTest::testCaseVer1_9x3()
     x = 9; y = 2;
     QCOMPARE(pData->getCellType(x,y), pd::CellType::CellAnswer);
     QCOMPARE(pData->getAnswer(x,y), 4);
+
+    // dense solution
+    const std::uint8_t *pSolution = pData->getSolution();
+    QCOMPARE(static_cast<int>(pSolution[9 + 2*10]), 4);
+    QCOMPARE(static_cast<int>(pSolution[6 + 1*10]), 0);
 }
 
 void ProblemLoaderTest::testCaseVer1InvalidAns()
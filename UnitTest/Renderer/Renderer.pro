@@ -0,0 +1,35 @@
+#-------------------------------------------------
+#
+# Headless board renderer test
+#
+#-------------------------------------------------
+
+QT       += testlib gui concurrent svg
+
+TARGET = tst_renderertest
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += testcase
+CONFIG   += c++11
+
+TEMPLATE = app
+
+
+SOURCES += tst_renderertest.cpp \
+    ../../Kakuro/boardrenderer.cpp \
+    ../../Kakuro/boardexport.cpp \
+    ../../Kakuro/problemdata.cpp \
+    ../../Common/glyphatlas.cpp \
+    ../../Common/boardpainter.cpp \
+    ../../Render/batchrender.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+HEADERS += \
+    ../../Kakuro/boardrenderer.h \
+    ../../Kakuro/boardexport.h \
+    ../../Kakuro/problemdata.h \
+    ../../Common/glyphatlas.h \
+    ../../Common/boardpainter.h \
+    ../../Render/batchrender.h
+
+INCLUDEPATH += ../../Kakuro ../../Common ../../Render
@@ -0,0 +1,241 @@
+#include <QString>
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFileInfo>
+#include <QImage>
+#include <memory>
+#include "boardrenderer.h"
+#include "boardexport.h"
+#include "batchrender.h"
+#include "problemdata.h"
+
+namespace pd = problemdata;
+
+class RendererTest : public QObject
+{
+    Q_OBJECT
+    const QString m_problemFile;
+
+    // # of pixels in rect that are not white
+    static int countInk(const QImage &image, const QRect &rect);
+
+public:
+    RendererTest();
+
+private Q_SLOTS:
+    void testCaseGeometry();
+    void testCaseRender();
+    void testCaseRenderScaled();
+    void testCaseClueCell();
+    void testCaseBatch();
+    void testCaseExport();
+    void testCaseBooklet();
+};
+
+RendererTest::RendererTest()
+    : m_problemFile(SRCDIR "../../SampleData/p001_9x3.kkr")
+{
+}
+
+int RendererTest::countInk(const QImage &image, const QRect &rect)
+{
+    int ink = 0;
+    for(int y = rect.top(); y <= rect.bottom(); ++y)
+        for(int x = rect.left(); x <= rect.right(); ++x)
+            if(image.pixel(x, y) != qRgb(255, 255, 255))
+                ++ink;
+    return ink;
+}
+
+void RendererTest::testCaseGeometry()
+{
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(m_problemFile)};
+    QVERIFY(pData != nullptr);
+
+    for(int row = 0; row < pData->getNumRows(); ++row) {
+        for(int col = 0; col < pData->getNumCols(); ++col) {
+            const QRect cellRect{BoardRenderer::getCellRect(col, row)};
+            QCOMPARE(BoardRenderer::getCellCoord(*pData, cellRect.x(), cellRect.y()), QPoint(col, row));
+            QCOMPARE(BoardRenderer::getCellCoord(*pData, cellRect.right(), cellRect.bottom()), QPoint(col, row));
+            QCOMPARE(BoardRenderer::getCellRange(*pData, cellRect), QRect(col, row, 1, 1));
+        }
+    }
+
+    // on the border, in the margin
+    const QRect cellRect{BoardRenderer::getCellRect(1, 1)};
+    QCOMPARE(BoardRenderer::getCellCoord(*pData, cellRect.right()+1, cellRect.y()), QPoint(-1, -1));
+    QCOMPARE(BoardRenderer::getCellCoord(*pData, 0, 0), QPoint(-1, -1));
+    QVERIFY(BoardRenderer::getCellRange(*pData, QRect(0, 0, 5, 5)).isEmpty());
+
+    const QSize boardSize{BoardRenderer::getBoardSize(pData->getNumCols(), pData->getNumRows())};
+    QCOMPARE(BoardRenderer::getCellRange(*pData, QRect(QPoint(0, 0), boardSize)),
+             QRect(0, 0, pData->getNumCols(), pData->getNumRows()));
+
+    // dirty rects: a block of cells maps back to exactly those cells
+    const QRect block{1, 0, 3, 2};
+    QCOMPARE(BoardPainter::getBlockRect(QRect(2, 1, 1, 1)), BoardPainter::getCellRect(2, 1));
+    QCOMPARE(BoardRenderer::getCellRange(*pData, BoardPainter::getBlockRect(block)), block);
+    QVERIFY(BoardPainter::getBlockRect(QRect()).isNull());
+}
+
+void RendererTest::testCaseRender()
+{
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(m_problemFile)};
+    QVERIFY(pData != nullptr);
+    const BoardRenderer renderer;
+
+    const QImage blank{renderer.render(*pData)};
+    QCOMPARE(blank.size(), BoardRenderer::getBoardSize(pData->getNumCols(), pData->getNumRows()));
+
+    // the top left corner is a clue cell with both clues closed
+    const QRect corner{BoardRenderer::getCellRect(0, 0)};
+    QCOMPARE(blank.pixel(corner.right()-3, corner.top()+3), qRgb(0, 0, 0));
+    QCOMPARE(blank.pixel(corner.left()+3, corner.bottom()-3), qRgb(0, 0, 0));
+
+    // answer cells are empty unless the solution is given
+    const QImage solved{renderer.render(*pData, pData->getSolution())};
+    for(int row = 0; row < pData->getNumRows(); ++row) {
+        for(int col = 0; col < pData->getNumCols(); ++col) {
+            if(pData->getCellType(col, row) != pd::CellType::CellAnswer)
+                continue;
+            const QRect cellRect{BoardRenderer::getCellRect(col, row)};
+            QCOMPARE(countInk(blank, cellRect), 0);
+            QVERIFY(countInk(solved, cellRect) > 0);
+        }
+    }
+}
+
+void RendererTest::testCaseRenderScaled()
+{
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(m_problemFile)};
+    QVERIFY(pData != nullptr);
+    const BoardRenderer renderer;
+    const QSize boardSize{BoardRenderer::getBoardSize(pData->getNumCols(), pData->getNumRows())};
+
+    const QImage large{renderer.render(*pData, pData->getSolution(), 2.0)};
+    QCOMPARE(large.size(), boardSize * 2);
+
+    // thumbnails have no digits; answer cells stay blank
+    const QImage thumb{renderer.render(*pData, pData->getSolution(), 0.25)};
+    QCOMPARE(thumb.width(), qCeil(boardSize.width() * 0.25));
+    for(int row = 0; row < pData->getNumRows(); ++row) {
+        for(int col = 0; col < pData->getNumCols(); ++col) {
+            if(pData->getCellType(col, row) != pd::CellType::CellAnswer)
+                continue;
+            const QRect cellRect{BoardRenderer::getCellRect(col, row)};
+            const QPoint center{cellRect.center() / 4};
+            QCOMPARE(thumb.pixel(center), qRgb(255, 255, 255));
+        }
+    }
+}
+
+void RendererTest::testCaseClueCell()
+{
+    // the editor's clue values: closed, empty and with a digit
+    const BoardPainter painter;
+    QImage image{BoardPainter::getBoardSize(3, 1), QImage::Format_RGB32};
+    image.fill(Qt::white);
+    QPainter p(&image);
+    painter.drawClueCell(p, 0, 0, BoardPainter::CLOSED_CLUE, BoardPainter::CLOSED_CLUE, true);
+    painter.drawClueCell(p, 1, 0, 0, 0, true);
+    painter.drawClueCell(p, 2, 0, 45, 45, true, BoardPainter::ClueHighlight::Right);
+    p.end();
+
+    const QRect closed{BoardPainter::getCellRect(0, 0)};
+    QCOMPARE(image.pixel(BoardPainter::getClueRectRight(closed).center()), qRgb(0, 0, 0));
+
+    const QRect empty{BoardPainter::getClueRectRight(BoardPainter::getCellRect(1, 0))};
+    QCOMPARE(countInk(image, empty), 0);
+
+    const QRect cellRect{BoardPainter::getCellRect(2, 0)};
+    QCOMPARE(image.pixel(BoardPainter::getClueRectRight(cellRect).topLeft()), qRgb(0, 255, 255));
+    QVERIFY(countInk(image, BoardPainter::getClueRectDown(cellRect)) > 0);
+}
+
+void RendererTest::testCaseBatch()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    RenderOptions options;
+    options.outputDir = dir.path();
+    options.format = RenderOptions::Format::Png;
+    options.scale = 1.0;
+    options.withSolution = true;
+
+    // the same name from another directory must not overwrite the first
+    QVERIFY(QDir(dir.path()).mkdir("other"));
+    const QString sameName{dir.path() + "/other/" + QFileInfo(m_problemFile).fileName()};
+    QVERIFY(QFile::copy(m_problemFile, sameName));
+
+    QStringList files;
+    files << m_problemFile << dir.path() + "/missing.kkr" << sameName;
+    QCOMPARE(renderBatch(files, options, 2), 1);
+
+    const QImage image{dir.path() + "/p001_9x3.png"};
+    QVERIFY(!image.isNull());
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(m_problemFile)};
+    QCOMPARE(image.size(), BoardRenderer::getBoardSize(pData->getNumCols(), pData->getNumRows()));
+    QVERIFY(!QImage(dir.path() + "/p001_9x3-2.png").isNull());
+}
+
+void RendererTest::testCaseExport()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(m_problemFile)};
+    QVERIFY(pData != nullptr);
+    const QSize boardSize{BoardRenderer::getBoardSize(pData->getNumCols(), pData->getNumRows())};
+
+    // digits stay text in the vector output
+    const QString svgFile{dir.path() + "/p.svg"};
+    QVERIFY(exportSvg(*pData, svgFile, pData->getSolution()));
+    QFile svg{svgFile};
+    QVERIFY(svg.open(QIODevice::ReadOnly));
+    const QByteArray svgData{svg.readAll()};
+    QVERIFY(svgData.contains("<svg"));
+    QVERIFY(svgData.contains(QString("viewBox=\"0 0 %1 %2\"").arg(boardSize.width()).arg(boardSize.height()).toLatin1()));
+    QVERIFY(svgData.contains("<text"));
+
+    const QString pdfFile{dir.path() + "/p.pdf"};
+    QVERIFY(exportPdf(*pData, pdfFile));
+    QFile pdf{pdfFile};
+    QVERIFY(pdf.open(QIODevice::ReadOnly));
+    QVERIFY(pdf.read(4) == "%PDF");
+
+    QVERIFY(!exportPdf(*pData, dir.path() + "/missing/p.pdf"));
+}
+
+void RendererTest::testCaseBooklet()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    std::unique_ptr<pd::ProblemData> pData{pd::ProblemData::problemLoader(m_problemFile)};
+    QVERIFY(pData != nullptr);
+
+    BookletOptions options;
+    options.cols = 2;
+    options.rows = 2;
+    const QString pdfFile{dir.path() + "/book.pdf"};
+    {
+        BookletWriter booklet{pdfFile, options};
+        QVERIFY(booklet.isOpen());
+        for(int i = 0; i < 9; ++i)
+            QVERIFY(booklet.addProblem(*pData));
+        QCOMPARE(booklet.getNumProblems(), 9);
+        QCOMPARE(booklet.getNumPages(), 3);
+        QVERIFY(booklet.finish());
+        QVERIFY(!booklet.addProblem(*pData));
+    }
+    QVERIFY(QFileInfo(pdfFile).size() > 0);
+
+    // files are loaded one by one; failures are skipped
+    QStringList files;
+    files << m_problemFile << dir.path() + "/missing.kkr" << m_problemFile;
+    QCOMPARE(renderBooklet(files, dir.path() + "/book2.pdf", options), 1);
+    QCOMPARE(renderBooklet(files, dir.path() + "/missing/book.pdf", options), -1);
+}
+
+QTEST_MAIN(RendererTest)
+
+#include "tst_renderertest.moc"
@@ -0,0 +1,34 @@
+#-------------------------------------------------
+#
+# Replay engine test
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_replaytest
+CONFIG   += console
+CONFIG   -= app_bundle
+CONFIG   += testcase
+CONFIG   += c++11
+
+TEMPLATE = app
+
+
+SOURCES += tst_replaytest.cpp \
+    ../UserAnswer/mock4useranswer.cpp \
+    ../../Kakuro/useranswer.cpp \
+    ../../Kakuro/useranswermanager.cpp \
+    ../../Kakuro/answerjournal.cpp \
+    ../../Kakuro/answercheck.cpp \
+    ../../Kakuro/replayengine.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+HEADERS += \
+    ../../Kakuro/useranswer.h \
+    ../../Kakuro/useranswermanager.h \
+    ../../Kakuro/answerjournal.h \
+    ../../Kakuro/answercheck.h \
+    ../../Kakuro/replayengine.h
@@ -0,0 +1,228 @@
+#include <QString>
+#include <QtTest>
+#include <QTemporaryDir>
+#include <memory>
+#include <vector>
+#include "../../Kakuro/replayengine.h"
+
+namespace pd = problemdata;
+namespace ua = useranswer;
+
+class ReplayTest : public QObject
+{
+    Q_OBJECT
+
+    // a random play on a numCols x numRows board; includes undo
+    static std::vector<ua::JournalRecord> makeRecords(int numCols, int numRows, int numMoves);
+    // plain sequential replay to compare with
+    static std::vector<int> replayUpTo(int numCols, int numRows,
+                                       const std::vector<ua::JournalRecord> &records, int position);
+    static bool sameBoard(const ua::SharedAnswer &pAns, const std::vector<int> &expected);
+
+public:
+    ReplayTest();
+
+private Q_SLOTS:
+    void testCaseEmpty();
+    void testCaseSeekForward();
+    void testCaseSeekRandom();
+    void testCaseUndoRecords();
+    void testCaseReload();
+    void testCaseInvalidRecords();
+    void testCaseLoadJournal();
+};
+
+ReplayTest::ReplayTest()
+{
+}
+
+std::vector<ua::JournalRecord> ReplayTest::makeRecords(int numCols, int numRows, int numMoves)
+{
+    std::vector<ua::JournalRecord> records;
+    std::vector<ua::CellData> undoStack;
+    std::vector<int> board(numCols*numRows, ua::ANSWER_NODATA);
+    qsrand(1234);
+
+    for(int i = 0; i < numMoves; ++i) {
+        ua::JournalRecord rec;
+        rec.time = i * 10;
+        if(!undoStack.empty() && qrand() % 4 == 0) {
+            const ua::CellData &undoData = undoStack.back();
+            rec.col = undoData.p.x(); rec.row = undoData.p.y();
+            rec.answer = undoData.answer;
+            rec.op = ua::JournalOp::Undo;
+            undoStack.pop_back();
+        } else {
+            rec.col = qrand() % numCols; rec.row = qrand() % numRows;
+            rec.answer = qrand() % 10;
+            rec.op = ua::JournalOp::Update;
+            ua::CellData undoData;
+            undoData.p = QPoint(rec.col, rec.row);
+            undoData.answer = board[rec.col + rec.row*numCols];
+            undoStack.push_back(undoData);
+        }
+        board[rec.col + rec.row*numCols] = rec.answer;
+        records.push_back(rec);
+    }
+
+    return records;
+}
+
+std::vector<int> ReplayTest::replayUpTo(int numCols, int numRows,
+                                        const std::vector<ua::JournalRecord> &records, int position)
+{
+    std::vector<int> board(numCols*numRows, ua::ANSWER_NODATA);
+    for(int i = 0; i < position; ++i)
+        board[records[i].col + records[i].row*numCols] = records[i].answer;
+    return board;
+}
+
+bool ReplayTest::sameBoard(const ua::SharedAnswer &pAns, const std::vector<int> &expected)
+{
+    const int cols = pAns->getNumCols();
+    for(int r = 0; r < pAns->getNumRows(); ++r)
+        for(int c = 0; c < cols; ++c)
+            if(pAns->getAnswer(c, r) != expected[c + r*cols])
+                return false;
+    return true;
+}
+
+void ReplayTest::testCaseEmpty()
+{
+    ua::ReplayEngine target;
+    std::vector<ua::JournalRecord> records;
+    target.load(5, 4, records);
+
+    QCOMPARE(target.getNumMoves(), 0);
+    QCOMPARE(target.getPosition(), 0);
+    target.seek(0);
+    QVERIFY(sameBoard(target.getAnswer(), std::vector<int>(5*4, ua::ANSWER_NODATA)));
+}
+
+void ReplayTest::testCaseSeekForward()
+{
+    const int cols = 7, rows = 6;
+    const auto records = makeRecords(cols, rows, 100);
+    ua::ReplayEngine target(8);
+    target.load(cols, rows, records);
+    QCOMPARE(target.getNumMoves(), 100);
+
+    for(int pos = 0; pos <= 100; ++pos) {
+        target.seek(pos);
+        QCOMPARE(target.getPosition(), pos);
+        QVERIFY(sameBoard(target.getAnswer(), replayUpTo(cols, rows, records, pos)));
+    }
+}
+
+void ReplayTest::testCaseSeekRandom()
+{
+    const int cols = 9, rows = 9;
+    const auto records = makeRecords(cols, rows, 1000);
+    ua::ReplayEngine target(16);
+    target.load(cols, rows, records);
+
+    const int positions[] = {1000, 0, 500, 499, 17, 16, 15, 999, 1, 640, 600, 620, 1000};
+    for(int pos : positions) {
+        target.seek(pos);
+        QCOMPARE(target.getPosition(), pos);
+        QVERIFY(sameBoard(target.getAnswer(), replayUpTo(cols, rows, records, pos)));
+    }
+}
+
+void ReplayTest::testCaseUndoRecords()
+{
+    std::vector<ua::JournalRecord> records;
+    ua::JournalRecord rec;
+    rec.time = 0; rec.col = 1; rec.row = 1; rec.answer = 3; rec.op = ua::JournalOp::Update;
+    records.push_back(rec);
+    rec.answer = 5;
+    records.push_back(rec);
+    rec.answer = 3; rec.op = ua::JournalOp::Undo;
+    records.push_back(rec);
+
+    ua::ReplayEngine target(2);
+    target.load(3, 3, records);
+    target.seek(3);
+    QCOMPARE(target.getAnswer()->getAnswer(1,1), 3);
+    target.seek(2);
+    QCOMPARE(target.getAnswer()->getAnswer(1,1), 5);
+    target.seek(0);
+    QCOMPARE(target.getAnswer()->getAnswer(1,1), ua::ANSWER_NODATA);
+    QCOMPARE(target.getMoveCell(2), QPoint(1,1));
+}
+
+void ReplayTest::testCaseReload()
+{
+    // the answer object is reused for a session of the same size
+    const int cols = 5, rows = 5;
+    ua::ReplayEngine target(4);
+    target.load(cols, rows, makeRecords(cols, rows, 50));
+    target.seek(50);
+    const ua::SharedAnswer pAns{target.getAnswer()};
+
+    std::vector<ua::JournalRecord> records;
+    target.load(cols, rows, records);
+    QCOMPARE(target.getAnswer(), pAns);
+    QVERIFY(sameBoard(pAns, std::vector<int>(cols*rows, ua::ANSWER_NODATA)));
+}
+
+void ReplayTest::testCaseInvalidRecords()
+{
+    const int cols = 4, rows = 3;
+    ua::ReplayEngine target(4);
+    QVERIFY(target.load(cols, rows, makeRecords(cols, rows, 20)));
+    target.seek(20);
+
+    // a cell outside the board or a value that is not a digit rejects the whole log
+    ua::JournalRecord rec;
+    rec.time = 0; rec.col = cols; rec.row = 1; rec.answer = 3; rec.op = ua::JournalOp::Update;
+    std::vector<ua::JournalRecord> records{makeRecords(cols, rows, 5)};
+    records.push_back(rec);
+    QVERIFY(!target.load(cols, rows, records));
+    records.back().col = 1;
+    records.back().row = -1;
+    QVERIFY(!target.load(cols, rows, records));
+    records.back().row = 1;
+    records.back().answer = 10;
+    QVERIFY(!target.load(cols, rows, records));
+
+    // the previous session is kept
+    QCOMPARE(target.getNumMoves(), 20);
+    QCOMPARE(target.getPosition(), 20);
+}
+
+void ReplayTest::testCaseLoadJournal()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journal{dir.path() + "/record.kkj"};
+
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader("4,10")};
+    {
+        ua::UserAnswerManager uam;
+        uam.updateProblem(pProblem);
+        uam.startJournal(journal);
+        ua::CellData cellData;
+        cellData.p.setX(1); cellData.p.setY(2); cellData.answer = 7;
+        uam.updateCellAnswer(cellData);
+        cellData.p.setX(3); cellData.p.setY(4); cellData.answer = 1;
+        uam.updateCellAnswer(cellData);
+        uam.undo();
+    }
+
+    ua::ReplayEngine target;
+    QVERIFY(target.load(*pProblem, journal));
+    QCOMPARE(target.getNumMoves(), 3);
+    target.seek(2);
+    QCOMPARE(target.getAnswer()->getAnswer(1,2), 7);
+    QCOMPARE(target.getAnswer()->getAnswer(3,4), 1);
+    target.seek(3);
+    QCOMPARE(target.getAnswer()->getAnswer(3,4), ua::ANSWER_NODATA);
+
+    std::shared_ptr<pd::ProblemData> pOther{pd::ProblemData::problemLoader("5,10")};
+    QVERIFY(!target.load(*pOther, journal));
+}
+
+QTEST_APPLESS_MAIN(ReplayTest)
+
+#include "tst_replaytest.moc"
@@ -5,4 +5,10 @@ SUBDIRS += \
     PlayStatus \
     UserAnswer \
     MetaData \
-    EditorBoard
+    EditorBoard \
+    Replay \
+    Renderer \
+    Navigation \
+    EditorSolver \
+    EditorFile \
+    EditorLayout
@@ -20,9 +20,13 @@ TEMPLATE = app
 SOURCES += tst_useranswertest.cpp \
     mock4useranswer.cpp \
     ../../Kakuro/useranswer.cpp \
-    ../../Kakuro/useranswermanager.cpp
+    ../../Kakuro/useranswermanager.cpp \
+    ../../Kakuro/answerjournal.cpp \
+    ../../Kakuro/answercheck.cpp
 DEFINES += SRCDIR=\\\"$$PWD/\\\"
 
 HEADERS += \
     ../../Kakuro/useranswer.h \
-    ../../Kakuro/useranswermanager.h
+    ../../Kakuro/useranswermanager.h \
+    ../../Kakuro/answerjournal.h \
+    ../../Kakuro/answercheck.h
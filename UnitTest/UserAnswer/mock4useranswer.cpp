@@ -1,5 +1,6 @@
 #include "../../Kakuro/problemdata.h"
 #include <QStringList>
+#include <vector>
 
 namespace problemdata {
 
@@ -7,6 +8,7 @@ class ProblemData_int {
 public:
     int cols;
     int rows;
+    std::vector<std::uint8_t> solution;
 };
 
 ProblemData::ProblemData(std::unique_ptr<ProblemData_int> m) : m_(std::move(m))
@@ -47,6 +49,11 @@ int ProblemData::getAnswer(int col, int row) const
     return (col+row)%9 + 1;
 }
 
+const std::uint8_t *ProblemData::getSolution() const
+{
+    return m_->solution.data();
+}
+
 ProblemData *ProblemData::problemLoader(const QString &filename)
 {
     ProblemData * pPd = new ProblemData(std::unique_ptr<ProblemData_int>(new ProblemData_int));
@@ -54,6 +61,13 @@ ProblemData *ProblemData::problemLoader(const QString &filename)
     pPd->m_->cols = l[0].toInt();
     pPd->m_->rows = l[1].toInt();
 
+    auto &solution = pPd->m_->solution;
+    solution.resize(pPd->m_->cols * pPd->m_->rows);
+    for(int r = 0; r < pPd->m_->rows; ++r)
+        for(int c = 0; c < pPd->m_->cols; ++c)
+            solution[c + r * pPd->m_->cols]
+                    = (pPd->getCellType(c, r) == CellType::CellAnswer ? pPd->getAnswer(c, r) : 0);
+
     return pPd;
 }
 
@@ -1,6 +1,8 @@
 #include <QString>
 #include <QtTest>
 #include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QFile>
 #include <memory>
 #include "../../Kakuro/useranswermanager.h"
 
@@ -21,9 +23,16 @@ private Q_SLOTS:
     void testCaseSolved();
     void testCaseNotSolvedWithAnEmptyCell();
     void testCaseNotSolvedWithAWrongAnswer();
+    void testCaseCheck();
     void testCaseSigUndoable();
     void testCaseUndoneContent();
     void testCaseUndoCellSignal();
+    void testCaseAnswerSpan();
+    void testCaseSnapshot();
+    void testCaseJournalRecovery();
+    void testCaseJournalArchiveCap();
+    void testCaseJournalTornRecord();
+    void testCaseJournalOtherBoard();
 };
 
 UserAnswerTest::UserAnswerTest()
@@ -177,6 +186,65 @@ void UserAnswerTest::testCaseNotSolvedWithAWrongAnswer()
     QCOMPARE(target.isSolved(), false);
 }
 
+void UserAnswerTest::testCaseCheck()
+{
+    useranswer::UserAnswerManager target;
+
+    const int numCols = 4;
+    const int numRows = 3;
+    const QString sSize = QString::asprintf("%d,%d", numCols, numRows);
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader(sSize)};
+    target.updateProblem(pProblem);
+
+    useranswer::CheckResult result;
+    target.check(result);
+    QCOMPARE(static_cast<int>(result.empty.size()), 6);
+    QVERIFY(result.wrong.empty());
+    QVERIFY(!result.isSolved());
+
+    useranswer::CellData cellData;
+    cellData.p.setX(1); cellData.p.setY(0); cellData.answer = 2;
+    target.updateCellAnswer(cellData);
+    cellData.p.setX(3); cellData.p.setY(0); cellData.answer = 4;
+    target.updateCellAnswer(cellData);
+    cellData.p.setX(0); cellData.p.setY(1); cellData.answer = 3/*2*/;
+    target.updateCellAnswer(cellData);
+    cellData.p.setX(2); cellData.p.setY(1); cellData.answer = 4;
+    target.updateCellAnswer(cellData);
+    cellData.p.setX(1); cellData.p.setY(2); cellData.answer = 5/*4*/;
+    target.updateCellAnswer(cellData);
+
+    target.check(result);
+    QCOMPARE(static_cast<int>(result.wrong.size()), 2);
+    QCOMPARE(result.wrong[0], 0 + 1*numCols);
+    QCOMPARE(result.wrong[1], 1 + 2*numCols);
+    QCOMPARE(static_cast<int>(result.empty.size()), 1);
+    QCOMPARE(result.empty[0], 3 + 2*numCols);
+
+    // larger than a vector block
+    std::shared_ptr<pd::ProblemData> pLarge{pd::ProblemData::problemLoader("40,30")};
+    target.updateProblem(pLarge);
+    for(int r = 0; r < 30; ++r) {
+        for(int c = 0; c < 40; ++c) {
+            if(pLarge->getCellType(c, r) == pd::CellType::CellAnswer) {
+                cellData.p.setX(c); cellData.p.setY(r);
+                cellData.answer = pLarge->getAnswer(c, r);
+                target.updateCellAnswer(cellData);
+            }
+        }
+    }
+    target.check(result);
+    QVERIFY(result.isSolved());
+    QVERIFY(target.isSolved());
+
+    cellData.p.setX(39); cellData.p.setY(28); cellData.answer = pLarge->getAnswer(39, 28) % 9 + 1;
+    target.updateCellAnswer(cellData);
+    target.check(result);
+    QCOMPARE(static_cast<int>(result.wrong.size()), 1);
+    QCOMPARE(result.wrong[0], 39 + 28*40);
+    QVERIFY(!target.isSolved());
+}
+
 void UserAnswerTest::testCaseSigUndoable()
 {
     useranswer::UserAnswerManager target;
@@ -302,6 +370,245 @@ void UserAnswerTest::testCaseUndoCellSignal()
     QCOMPARE(pos, QPoint(col, row));
 }
 
+void UserAnswerTest::testCaseAnswerSpan()
+{
+    useranswer::UserAnswerManager target;
+    qRegisterMetaType<useranswer::SharedAnswer>("SharedAnswer");
+    QSignalSpy spy(&target, &useranswer::UserAnswerManager::newUserAnswer);
+
+    const int numCols = 4;
+    const int numRows = 10;
+    const QString sSize = QString::asprintf("%d,%d", numCols, numRows);
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader(sSize)};
+    target.updateProblem(pProblem);
+    useranswer::SharedAnswer pAns{qvariant_cast<useranswer::SharedAnswer>(spy.at(0).at(0))};
+
+    useranswer::CellData cellData;
+    cellData.p.setX(3); cellData.p.setY(2); cellData.answer = 9;
+    target.updateCellAnswer(cellData);
+
+    QCOMPARE(pAns->getNumChunks(), 1);
+    const useranswer::AnswerSpan span{pAns->getChunk(0)};
+    QCOMPARE(span.size, numCols*numRows);
+    QCOMPARE(static_cast<int>(span.data[3 + 2*numCols]), 9);
+
+    int sum = 0;
+    for(const auto a : span)
+        sum += a;
+    QCOMPARE(sum, 9);
+}
+
+void UserAnswerTest::testCaseSnapshot()
+{
+    useranswer::UserAnswerManager target;
+    qRegisterMetaType<useranswer::SharedAnswer>("SharedAnswer");
+    QSignalSpy spy(&target, &useranswer::UserAnswerManager::newUserAnswer);
+
+    // large enough for several chunks
+    const int numCols = 100;
+    const int numRows = 100;
+    const QString sSize = QString::asprintf("%d,%d", numCols, numRows);
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader(sSize)};
+    target.updateProblem(pProblem);
+    useranswer::SharedAnswer pAns{qvariant_cast<useranswer::SharedAnswer>(spy.at(0).at(0))};
+    QCOMPARE(pAns->getNumChunks(), 3);
+    QCOMPARE(pAns->getChunk(2).size, numCols*numRows - 2*useranswer::UserAnswer::CHUNK_SIZE);
+
+    useranswer::CellData cellData;
+    cellData.p.setX(1); cellData.p.setY(1); cellData.answer = 5;
+    target.updateCellAnswer(cellData);
+
+    useranswer::AnswerSnapshot pSnap{target.snapshot()};
+    QCOMPARE(pSnap->getVersion(), pAns->getVersion());
+    for(int k = 0; k < pAns->getNumChunks(); ++k)
+        QCOMPARE(pSnap->getChunk(k).data, pAns->getChunk(k).data);
+
+    // write to the last chunk; only that chunk is copied
+    const unsigned long long version = pAns->getVersion();
+    cellData.p.setX(99); cellData.p.setY(99); cellData.answer = 7;
+    target.updateCellAnswer(cellData);
+    QVERIFY(pAns->getVersion() > version);
+    QCOMPARE(pSnap->getVersion(), version);
+    QCOMPARE(pAns->getAnswer(99, 99), 7);
+    QCOMPARE(pSnap->getAnswer(99, 99), useranswer::ANSWER_NODATA);
+    QCOMPARE(pSnap->getAnswer(1, 1), 5);
+    QCOMPARE(pSnap->getChunk(0).data, pAns->getChunk(0).data);
+    QCOMPARE(pSnap->getChunk(1).data, pAns->getChunk(1).data);
+    QVERIFY(pSnap->getChunk(2).data != pAns->getChunk(2).data);
+
+    // the live answers keep their private chunk for subsequent writes
+    const std::uint8_t *pChunk = pAns->getChunk(2).data;
+    target.undo();
+    QCOMPARE(pAns->getChunk(2).data, pChunk);
+    QCOMPARE(pAns->getAnswer(99, 99), useranswer::ANSWER_NODATA);
+}
+
+void UserAnswerTest::testCaseJournalRecovery()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journal{dir.path() + "/journal.kkj"};
+
+    const int numCols = 4;
+    const int numRows = 10;
+    const QString sSize = QString::asprintf("%d,%d", numCols, numRows);
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader(sSize)};
+
+    {
+        useranswer::UserAnswerManager target;
+        qint64 clock = 0;
+        target.setClock([&clock]() {return clock;});
+        target.updateProblem(pProblem);
+        QCOMPARE(target.startJournal(journal), false);
+
+        useranswer::CellData cellData;
+        cellData.p.setX(1); cellData.p.setY(1); cellData.answer = 2;
+        clock = 100;
+        target.updateCellAnswer(cellData);
+        cellData.p.setX(2); cellData.p.setY(3); cellData.answer = 9;
+        clock = 200;
+        target.updateCellAnswer(cellData);
+        cellData.answer = 5;
+        clock = 300;
+        target.updateCellAnswer(cellData);
+        clock = 400;
+        target.undo();
+        // the journal is synced when the manager goes away
+    }
+
+    useranswer::UserAnswerManager target;
+    qRegisterMetaType<useranswer::SharedAnswer>("SharedAnswer");
+    QSignalSpy spy(&target, &useranswer::UserAnswerManager::newUserAnswer);
+    target.updateProblem(pProblem);
+    QSignalSpy undoSpy(&target, &useranswer::UserAnswerManager::undoable);
+
+    qint64 lastTime = 0;
+    QCOMPARE(target.startJournal(journal, &lastTime), true);
+    QCOMPARE(lastTime, qint64(400));
+    QCOMPARE(spy.count(), 2);
+    // the game is still READY; Undo must not be enabled by the recovery
+    QCOMPARE(undoSpy.count(), 0);
+
+    useranswer::SharedAnswer pAns{qvariant_cast<useranswer::SharedAnswer>(spy.at(1).at(0))};
+    QCOMPARE(pAns->getAnswer(1,1), 2);
+    QCOMPARE(pAns->getAnswer(2,3), 9);
+    QVERIFY(target.isUndoable());
+
+    // the undo stack is recovered as well
+    target.undo();
+    QCOMPARE(pAns->getAnswer(2,3), useranswer::ANSWER_NODATA);
+    target.undo();
+    QCOMPARE(pAns->getAnswer(1,1), useranswer::ANSWER_NODATA);
+    QVERIFY(!target.isUndoable());
+
+    // a finished play is kept as a record, never to be recovered again
+    const QString record{dir.path() + "/record.kkj"};
+    QVERIFY(target.archiveJournal(record));
+    QVERIFY(!QFile::exists(journal));
+    QVERIFY(QFile::exists(record));
+    QVERIFY(!target.archiveJournal(record));
+}
+
+void UserAnswerTest::testCaseJournalArchiveCap()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journal{dir.path() + "/journal.kkj"};
+
+    const QString sSize = QString::asprintf("%d,%d", 4, 10);
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader(sSize)};
+    QDir records{dir.path() + "/records"};
+    QVERIFY(records.mkpath(QStringLiteral(".")));
+
+    // the newest two records are kept
+    for(int k = 1; k <= 3; ++k) {
+        useranswer::UserAnswerManager target;
+        target.updateProblem(pProblem);
+        target.startJournal(journal);
+        useranswer::CellData cellData;
+        cellData.p.setX(1); cellData.p.setY(1); cellData.answer = k;
+        target.updateCellAnswer(cellData);
+        QVERIFY(target.archiveJournal(records.filePath(QString::asprintf("p-%d.kkj", k)), 2));
+    }
+    QCOMPARE(records.entryList(QDir::Files), QStringList({"p-2.kkj", "p-3.kkj"}));
+}
+
+void UserAnswerTest::testCaseJournalTornRecord()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journal{dir.path() + "/journal.kkj"};
+
+    const int numCols = 4;
+    const int numRows = 10;
+    const QString sSize = QString::asprintf("%d,%d", numCols, numRows);
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader(sSize)};
+
+    {
+        useranswer::UserAnswerManager target;
+        target.updateProblem(pProblem);
+        target.startJournal(journal);
+        useranswer::CellData cellData;
+        cellData.p.setX(1); cellData.p.setY(2); cellData.answer = 7;
+        target.updateCellAnswer(cellData);
+    }
+
+    // simulate a record cut off by a power loss
+    {
+        QFile f{journal};
+        QVERIFY(f.open(QIODevice::Append));
+        f.write("\x00\x01\x02\x03\x04", 5);
+    }
+
+    {
+        useranswer::UserAnswerManager target;
+        qRegisterMetaType<useranswer::SharedAnswer>("SharedAnswer");
+        QSignalSpy spy(&target, &useranswer::UserAnswerManager::newUserAnswer);
+        target.updateProblem(pProblem);
+        QCOMPARE(target.startJournal(journal), true);
+        useranswer::SharedAnswer pAns{qvariant_cast<useranswer::SharedAnswer>(spy.at(1).at(0))};
+        QCOMPARE(pAns->getAnswer(1,2), 7);
+
+        // new moves go after the last valid record
+        useranswer::CellData cellData;
+        cellData.p.setX(3); cellData.p.setY(4); cellData.answer = 1;
+        target.updateCellAnswer(cellData);
+    }
+
+    useranswer::UserAnswerManager target;
+    qRegisterMetaType<useranswer::SharedAnswer>("SharedAnswer");
+    QSignalSpy spy(&target, &useranswer::UserAnswerManager::newUserAnswer);
+    target.updateProblem(pProblem);
+    QCOMPARE(target.startJournal(journal), true);
+    useranswer::SharedAnswer pAns{qvariant_cast<useranswer::SharedAnswer>(spy.at(1).at(0))};
+    QCOMPARE(pAns->getAnswer(1,2), 7);
+    QCOMPARE(pAns->getAnswer(3,4), 1);
+}
+
+void UserAnswerTest::testCaseJournalOtherBoard()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journal{dir.path() + "/journal.kkj"};
+
+    {
+        std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader("4,10")};
+        useranswer::UserAnswerManager target;
+        target.updateProblem(pProblem);
+        target.startJournal(journal);
+        useranswer::CellData cellData;
+        cellData.p.setX(1); cellData.p.setY(2); cellData.answer = 7;
+        target.updateCellAnswer(cellData);
+    }
+
+    // a journal of a different board size is not replayed but restarted
+    std::shared_ptr<pd::ProblemData> pProblem{pd::ProblemData::problemLoader("5,10")};
+    useranswer::UserAnswerManager target;
+    target.updateProblem(pProblem);
+    QCOMPARE(target.startJournal(journal), false);
+    QVERIFY(!target.isUndoable());
+}
+
 QTEST_APPLESS_MAIN(UserAnswerTest)
 
 #include "tst_useranswertest.moc"